@@ -0,0 +1,500 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "list.h"
+#include "tarjan.h"
+#include "hasse.h"
+#include "matrix.h"
+#include "propagation.h"
+#include "alias.h"
+#include "alea.h"
+#include "generateur.h"
+#include "instrum.h"
+#include "erreurs.h"
+#include "tuiles.h"
+#include "compression.h"
+#include "renumerotation.h"
+#include "analyse_classes.h"
+#include "limite.h"
+#include "mise_a_jour.h"
+#include "bench.h"
+
+/* Benchmarks des étapes de l'analyse sur des chaînes synthétiques.
+ * Chaque mesure produit une ligne JSON (ou CSV) : générateur, taille,
+ * nombre d'arêtes, étape, nombre de répétitions, temps min/moyen/max.
+ * Avec --verifier, les noyaux optimisés sont comparés aux calculs de
+ * référence et à des temps enregistrés (voir verification.c).
+ */
+
+#define FICHIER_TEMPORAIRE "bench_chaine_tmp.txt"
+#define FICHIER_HASSE_TEMPORAIRE "bench_hasse_tmp.txt"
+#define FICHIER_TUILES_TEMPORAIRE "bench_tuiles_tmp.bin"
+#define FICHIER_PRODUIT_TEMPORAIRE "bench_produit_tmp.bin"
+// Nombre de transitions tirées par la mesure des tables d'alias
+#define NB_TIRAGES 10000000
+
+// Mesures d'une étape
+typedef struct {
+    double min;
+    double max;
+    double somme;
+    int nb;
+} t_mesure;
+
+static void ajouter_mesure(t_mesure *m, double duree) {
+    if (m->nb == 0 || duree < m->min) m->min = duree;
+    if (m->nb == 0 || duree > m->max) m->max = duree;
+    m->somme += duree;
+    m->nb++;
+}
+
+static void ecrire_resultat(FILE *out, const t_params_bench *p, const char *gen, int n, int nb_aretes,
+                            const char *etape, const t_mesure *m) {
+    if (p->csv) {
+        fprintf(out, "%s,%d,%d,%s,%d,%.9f,%.9f,%.9f\n", gen, n, nb_aretes, etape, m->nb,
+                m->min, m->somme / m->nb, m->max);
+    } else {
+        fprintf(out, "{\"generateur\":\"%s\",\"n\":%d,\"aretes\":%d,\"etape\":\"%s\","
+                     "\"repetitions\":%d,\"min_s\":%.9f,\"moy_s\":%.9f,\"max_s\":%.9f}\n",
+                gen, n, nb_aretes, etape, m->nb, m->min, m->somme / m->nb, m->max);
+    }
+    fflush(out);
+}
+
+static int compter_aretes(listeAdj *g) {
+    int nb = 0;
+    for (int i = 0; i < g->nb_sommets; i++) {
+        for (cell *c = g->tab_liste[i].head; c != NULL; c = c->suivante) nb++;
+    }
+    return nb;
+}
+
+// Calcule M^n par multiplications successives (comme le mode interactif)
+t_matrix* puissance_naive(t_matrix *M, int n) {
+    t_matrix *courante = creer_matrice_valzeros(M->lignes, M->cols);
+    copie_matrice(M, courante);
+    for (int i = 2; i <= n; i++) {
+        t_matrix *temp = multiplication_matrice(courante, M);
+        liberer_matrice(courante);
+        courante = temp;
+    }
+    return courante;
+}
+
+// Exécute toutes les étapes sur une chaîne et écrit une ligne par étape
+static void mesurer_chaine(FILE *out, const t_params_bench *p, t_type_generateur type, int taille) {
+    const char *gen = nom_generateur(type);
+    listeAdj g = generer_chaine(type, taille, p->degre, p->graine);
+    int n = g.nb_sommets;
+    int nb_aretes = compter_aretes(&g);
+    ecrireGraphe(g, FICHIER_TEMPORAIRE);
+
+    t_mesure m;
+
+    // Chargement
+    memset(&m, 0, sizeof(m));
+    for (int r = 0; r < p->repetitions; r++) {
+        double t0 = horloge_monotone();
+        listeAdj lu = readGraph(FICHIER_TEMPORAIRE);
+        ajouter_mesure(&m, horloge_monotone() - t0);
+        liberer_listeAdj(&lu);
+    }
+    ecrire_resultat(out, p, gen, n, nb_aretes, "chargement", &m);
+
+    // Tarjan
+    memset(&m, 0, sizeof(m));
+    t_partition *partition = NULL;
+    for (int r = 0; r < p->repetitions; r++) {
+        liberer_partition(partition);
+        double t0 = horloge_monotone();
+        partition = tarjan_calculer_partition(g);
+        ajouter_mesure(&m, horloge_monotone() - t0);
+    }
+    ecrire_resultat(out, p, gen, n, nb_aretes, "tarjan", &m);
+
+    // Hasse : liens entre classes, suppression des redondances, écriture Mermaid
+    memset(&m, 0, sizeof(m));
+    for (int r = 0; r < p->repetitions; r++) {
+        double t0 = horloge_monotone();
+        int *corresp = creer_tab_corresp(partition, n);
+        t_link_array *liens = rencenser(&g, corresp);
+        genererHasseMermaid(partition, liens, FICHIER_HASSE_TEMPORAIRE, 0);
+        ajouter_mesure(&m, horloge_monotone() - t0);
+        free(liens->links);
+        free(liens);
+        free(corresp);
+    }
+    ecrire_resultat(out, p, gen, n, nb_aretes, "hasse", &m);
+
+    // Propagation creuse d'une distribution uniforme sur n pas
+    memset(&m, 0, sizeof(m));
+    t_matrix *init = creer_matrice_valzeros(1, n);
+    for (int i = 0; i < n; i++) init->data[0][i] = 1.0 / n;
+    for (int r = 0; r < p->repetitions; r++) {
+        double t0 = horloge_monotone();
+        t_matrix *res = propager_distributions(&g, init, p->puissance);
+        ajouter_mesure(&m, horloge_monotone() - t0);
+        liberer_matrice(res);
+    }
+    ecrire_resultat(out, p, gen, n, nb_aretes, "propagation", &m);
+
+    // Graphe compressé (probabilités sur 16 bits) : construction, Tarjan et propagation décodés au vol
+    memset(&m, 0, sizeof(m));
+    t_graphe_compresse *gc = NULL;
+    for (int r = 0; r < p->repetitions; r++) {
+        liberer_graphe_compresse(gc);
+        double t0 = horloge_monotone();
+        gc = compresser_graphe(&g, COMPRESSION_QUANTIFIEE);
+        ajouter_mesure(&m, horloge_monotone() - t0);
+    }
+    ecrire_resultat(out, p, gen, n, nb_aretes, "compression", &m);
+
+    memset(&m, 0, sizeof(m));
+    for (int r = 0; r < p->repetitions; r++) {
+        double t0 = horloge_monotone();
+        t_partition *classes = compresse_partition(gc);
+        ajouter_mesure(&m, horloge_monotone() - t0);
+        liberer_partition(classes);
+    }
+    ecrire_resultat(out, p, gen, n, nb_aretes, "tarjan_compresse", &m);
+
+    memset(&m, 0, sizeof(m));
+    for (int r = 0; r < p->repetitions; r++) {
+        double t0 = horloge_monotone();
+        t_matrix *res = propager_distributions_compresse(gc, init, p->puissance);
+        ajouter_mesure(&m, horloge_monotone() - t0);
+        liberer_matrice(res);
+    }
+    ecrire_resultat(out, p, gen, n, nb_aretes, "propagation_compressee", &m);
+    liberer_graphe_compresse(gc);
+
+    // Renumérotation pour la localité, puis Tarjan et propagation sur le graphe renuméroté
+    // (résultats ramenés aux numéros d'origine, comme dans l'analyse)
+    memset(&m, 0, sizeof(m));
+    t_permutation *perm = NULL;
+    listeAdj gp = {NULL, 0};
+    for (int r = 0; r < p->repetitions; r++) {
+        liberer_permutation(perm);
+        liberer_listeAdj(&gp);
+        double t0 = horloge_monotone();
+        perm = calculer_permutation(&g, partition, p->ordre);
+        gp = permuter_graphe(&g, perm);
+        ajouter_mesure(&m, horloge_monotone() - t0);
+    }
+    ecrire_resultat(out, p, gen, n, nb_aretes, "renumerotation", &m);
+
+    memset(&m, 0, sizeof(m));
+    for (int r = 0; r < p->repetitions; r++) {
+        double t0 = horloge_monotone();
+        t_partition *classes = tarjan_calculer_partition(gp);
+        restaurer_partition(classes, perm);
+        ajouter_mesure(&m, horloge_monotone() - t0);
+        liberer_partition(classes);
+    }
+    ecrire_resultat(out, p, gen, n, nb_aretes, "tarjan_renumerote", &m);
+
+    memset(&m, 0, sizeof(m));
+    for (int r = 0; r < p->repetitions; r++) {
+        double t0 = horloge_monotone();
+        t_matrix *initp = permuter_colonnes(init, perm, PERMUTER);
+        t_matrix *resp = propager_distributions(&gp, initp, p->puissance);
+        t_matrix *res = permuter_colonnes(resp, perm, RESTAURER);
+        ajouter_mesure(&m, horloge_monotone() - t0);
+        liberer_matrice(res);
+        liberer_matrice(resp);
+        liberer_matrice(initp);
+    }
+    ecrire_resultat(out, p, gen, n, nb_aretes, "propagation_renumerotee", &m);
+    liberer_listeAdj(&gp);
+    liberer_permutation(perm);
+    liberer_matrice(init);
+
+    // Tables d'alias : construction, puis NB_TIRAGES transitions d'une marche
+    memset(&m, 0, sizeof(m));
+    t_alias *tables = NULL;
+    for (int r = 0; r < p->repetitions; r++) {
+        liberer_alias(tables);
+        double t0 = horloge_monotone();
+        tables = creer_alias(&g);
+        ajouter_mesure(&m, horloge_monotone() - t0);
+    }
+    ecrire_resultat(out, p, gen, n, nb_aretes, "alias", &m);
+
+    memset(&m, 0, sizeof(m));
+    unsigned long long cle = alea_cle(p->graine, 0);
+    volatile int puits = 0;
+    for (int r = 0; r < p->repetitions; r++) {
+        int s = 0;
+        double t0 = horloge_monotone();
+        for (unsigned long long t = 0; t < NB_TIRAGES; t++) {
+            s = alias_tirer(tables, s, alea_uniforme(cle, t));
+        }
+        ajouter_mesure(&m, horloge_monotone() - t0);
+        puits += s;
+    }
+    ecrire_resultat(out, p, gen, n, nb_aretes, "tirages", &m);
+    liberer_alias(tables);
+
+    // Loi stationnaire après la modification d'une ligne : recalcul complet (Tarjan et limite)
+    // contre mise à jour par poussées du résidu (chaînes irréductibles seulement), avec le même
+    // budget : 1000 poussées par état, soit le coût des 1000 itérations de la limite
+    int ligne = 0;
+    while (ligne < n && (g.tab_liste[ligne].head == NULL || g.tab_liste[ligne].head->suivante == NULL)) ligne++;
+    if (partition->taille == 1 && ligne < n) {
+        cell *a = g.tab_liste[ligne].head, *b = a->suivante;
+        t_modification mods[2] = {{ligne + 1, a->sommet_arrivee, a->proba + 0.5 * b->proba},
+                                  {ligne + 1, b->sommet_arrivee, 0.5 * b->proba}};
+        t_modification inverses[2] = {{ligne + 1, a->sommet_arrivee, a->proba},
+                                      {ligne + 1, b->sommet_arrivee, b->proba}};
+        t_limite *lim = calculer_limite(&g, partition, 1e-10, 1000);
+        double *pi = malloc(n * sizeof(double));
+
+        memset(&m, 0, sizeof(m));
+        for (int r = 0; r < p->repetitions; r++) {
+            appliquer_modifications(&g, mods, 2, NULL);
+            double t0 = horloge_monotone();
+            t_partition *classes = tarjan_calculer_partition(g);
+            t_limite *nouvelle = calculer_limite(&g, classes, 1e-10, 1000);
+            ajouter_mesure(&m, horloge_monotone() - t0);
+            liberer_limite(nouvelle);
+            liberer_partition(classes);
+            appliquer_modifications(&g, inverses, 2, NULL);
+        }
+        ecrire_resultat(out, p, gen, n, nb_aretes, "stationnaire_complet", &m);
+
+        memset(&m, 0, sizeof(m));
+        for (int r = 0; r < p->repetitions; r++) {
+            memcpy(pi, lim->stationnaire, n * sizeof(double));
+            t_bilan_maj bilan;
+            double t0 = horloge_monotone();
+            mettre_a_jour_stationnaire(&g, pi, mods, 2, 1e-8 / n, 1000LL * n, &bilan);
+            ajouter_mesure(&m, horloge_monotone() - t0);
+            appliquer_modifications(&g, inverses, 2, NULL);
+        }
+        ecrire_resultat(out, p, gen, n, nb_aretes, "stationnaire_incremental", &m);
+
+        free(pi);
+        liberer_limite(lim);
+    }
+
+    // Étapes denses (N x N) : seulement pour les petites chaînes
+    if (n <= p->dense_max) {
+        t_matrix *M = creer_matrice_liste_adjacence(&g);
+
+        memset(&m, 0, sizeof(m));
+        for (int r = 0; r < p->repetitions; r++) {
+            double t0 = horloge_monotone();
+            t_matrix *Mn = puissance_naive(M, p->puissance);
+            ajouter_mesure(&m, horloge_monotone() - t0);
+            liberer_matrice(Mn);
+        }
+        ecrire_resultat(out, p, gen, n, nb_aretes, "puissance", &m);
+
+        memset(&m, 0, sizeof(m));
+        for (int r = 0; r < p->repetitions; r++) {
+            int iterations;
+            double diff;
+            double t0 = horloge_monotone();
+            t_matrix *Mk = converger_puissances(M, 0.01, 1000, &iterations, &diff);
+            ajouter_mesure(&m, horloge_monotone() - t0);
+            liberer_matrice(Mk);
+        }
+        ecrire_resultat(out, p, gen, n, nb_aretes, "convergence", &m);
+
+        memset(&m, 0, sizeof(m));
+        for (int r = 0; r < p->repetitions; r++) {
+            double t0 = horloge_monotone();
+            for (int c = 0; c < partition->taille; c++) {
+                t_matrix *sous = extractSquareSubMatrix(M, partition, c);
+                getPeriod(sous);
+                liberer_matrice(sous);
+            }
+            ajouter_mesure(&m, horloge_monotone() - t0);
+        }
+        ecrire_resultat(out, p, gen, n, nb_aretes, "periode", &m);
+
+        // Même calcul sur des vues de M : aucune sous-matrice copiée
+        memset(&m, 0, sizeof(m));
+        for (int r = 0; r < p->repetitions; r++) {
+            double t0 = horloge_monotone();
+            for (int c = 0; c < partition->taille; c++) {
+                t_vue_matrice vue;
+                if (vue_sous_matrice_carree(M, partition, c, &vue) == MARKOV_OK) vue_periode(&vue);
+            }
+            ajouter_mesure(&m, horloge_monotone() - t0);
+        }
+        ecrire_resultat(out, p, gen, n, nb_aretes, "periode_vue", &m);
+
+        // Analyse complète des classes (période, loi stationnaire, statistiques) avec vol de tâches
+        memset(&m, 0, sizeof(m));
+        for (int r = 0; r < p->repetitions; r++) {
+            double t0 = horloge_monotone();
+            t_analyse_classes *analyses = analyser_classes(&g, partition, 1e-9, 1000, p->nb_threads);
+            ajouter_mesure(&m, horloge_monotone() - t0);
+            liberer_analyse_classes(analyses);
+        }
+        ecrire_resultat(out, p, gen, n, nb_aretes, "classes_paralleles", &m);
+
+        // Produit M * M hors mémoire (fichiers projetés, tuiles adaptées à la taille de la chaîne)
+        int taille_tuile = ((n + MULTIPLE_TUILE - 1) / MULTIPLE_TUILE) * MULTIPLE_TUILE;
+        if (taille_tuile > TAILLE_TUILE_DEFAUT) taille_tuile = TAILLE_TUILE_DEFAUT;
+        t_matrice_tuiles *Mt = tuiles_depuis_liste(&g, FICHIER_TUILES_TEMPORAIRE, taille_tuile);
+        if (Mt != NULL) {
+            memset(&m, 0, sizeof(m));
+            for (int r = 0; r < p->repetitions; r++) {
+                double t0 = horloge_monotone();
+                t_matrice_tuiles *produit = multiplication_tuiles(Mt, Mt, FICHIER_PRODUIT_TEMPORAIRE);
+                ajouter_mesure(&m, horloge_monotone() - t0);
+                liberer_matrice_tuiles(produit, 1);
+            }
+            ecrire_resultat(out, p, gen, n, nb_aretes, "produit_tuiles", &m);
+            liberer_matrice_tuiles(Mt, 1);
+        }
+
+        liberer_matrice(M);
+    }
+
+    liberer_partition(partition);
+    liberer_listeAdj(&g);
+    remove(FICHIER_TEMPORAIRE);
+    remove(FICHIER_HASSE_TEMPORAIRE);
+}
+
+static void afficher_aide_bench(const char *prog) {
+    printf("Utilisation : %s [options]\n", prog);
+    printf("  -g, --generateurs LISTE  aleatoire,bande,anneau,petites_scc,chemin,bande_melangee\n");
+    printf("                           (defaut : tous)\n");
+    printf("  -t, --tailles LISTE      tailles des chaines (defaut : 100,1000,10000)\n");
+    printf("  -k, --degre D            degre / periode / taille des classes (defaut 4)\n");
+    printf("  -r, --repetitions R      repetitions par mesure (defaut 3)\n");
+    printf("  -D, --dense-max N        taille max pour les etapes denses (defaut 200)\n");
+    printf("  -n, --puissance N        puissance n pour M^n et la propagation (defaut 10)\n");
+    printf("  -R, --ordre ORDRE        renumerotation : origine, classes, largeur ou rcm (defaut rcm)\n");
+    printf("  -j, --threads T          threads de l'analyse des classes (defaut 0 : un par processeur)\n");
+    printf("  -s, --graine S           graine des generateurs (defaut 42)\n");
+    printf("  -o, --sortie FICHIER     fichier de resultats (defaut bench_resultats.jsonl)\n");
+    printf("  -f, --format json|csv    format des resultats (defaut json)\n");
+    printf("  -V, --verifier FICHIER   compare les noyaux optimises aux calculs de reference et leurs\n");
+    printf("                           temps a ceux de FICHIER (crees s'ils manquent) ; code 1 si echec\n");
+    printf("  -m, --marge PCT          ralentissement tolere par rapport a FICHIER (defaut 25)\n");
+    printf("  -e, --ecart TOL          ecart numerique tolere avec la reference (defaut 1e-9)\n");
+    printf("  -E, --enregistrer oui|non  remplace les temps de FICHIER par ceux mesures (defaut non)\n");
+}
+
+static int est_option(const char *arg, const char *courte, const char *longue) {
+    return strcmp(arg, courte) == 0 || strcmp(arg, longue) == 0;
+}
+
+int main(int argc, char **argv) {
+    t_params_bench p;
+    p.generateurs = (1u << GEN_NB) - 1;
+    p.tailles[0] = 100;
+    p.tailles[1] = 1000;
+    p.tailles[2] = 10000;
+    p.nb_tailles = 3;
+    p.degre = 4;
+    p.graine = 42;
+    p.repetitions = 3;
+    p.dense_max = 200;
+    p.puissance = 10;
+    p.ordre = ORDRE_RCM;
+    p.nb_threads = 0;
+    p.sortie = "bench_resultats.jsonl";
+    p.csv = 0;
+    p.reference = NULL;
+    p.marge = 25.0;
+    p.tolerance = 1e-9;
+    p.enregistrer = 0;
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        if (est_option(arg, "-h", "--aide")) {
+            afficher_aide_bench(argv[0]);
+            return 0;
+        }
+        if (i + 1 >= argc) {
+            fprintf(stderr, "Option %s : valeur manquante\n", arg);
+            return 1;
+        }
+        char *val = argv[++i];
+
+        if (est_option(arg, "-g", "--generateurs")) {
+            p.generateurs = 0;
+            for (char *mot = strtok(val, ","); mot != NULL; mot = strtok(NULL, ",")) {
+                int t = generateur_depuis_nom(mot);
+                if (t < 0) {
+                    fprintf(stderr, "Generateur inconnu : %s\n", mot);
+                    return 1;
+                }
+                p.generateurs |= 1u << t;
+            }
+        } else if (est_option(arg, "-t", "--tailles")) {
+            p.nb_tailles = 0;
+            for (char *mot = strtok(val, ","); mot != NULL && p.nb_tailles < MAX_TAILLES; mot = strtok(NULL, ",")) {
+                p.tailles[p.nb_tailles++] = atoi(mot);
+            }
+        } else if (est_option(arg, "-k", "--degre")) {
+            p.degre = atoi(val);
+        } else if (est_option(arg, "-r", "--repetitions")) {
+            p.repetitions = atoi(val);
+        } else if (est_option(arg, "-D", "--dense-max")) {
+            p.dense_max = atoi(val);
+        } else if (est_option(arg, "-n", "--puissance")) {
+            p.puissance = atoi(val);
+        } else if (est_option(arg, "-R", "--ordre")) {
+            int ordre = ordre_depuis_nom(val);
+            if (ordre < 0) {
+                fprintf(stderr, "Ordre inconnu : %s\n", val);
+                return 1;
+            }
+            p.ordre = ordre;
+        } else if (est_option(arg, "-j", "--threads")) {
+            p.nb_threads = atoi(val);
+        } else if (est_option(arg, "-s", "--graine")) {
+            p.graine = strtoull(val, NULL, 10);
+        } else if (est_option(arg, "-o", "--sortie")) {
+            p.sortie = val;
+        } else if (est_option(arg, "-f", "--format")) {
+            p.csv = (strcmp(val, "csv") == 0);
+        } else if (est_option(arg, "-V", "--verifier")) {
+            p.reference = val;
+        } else if (est_option(arg, "-m", "--marge")) {
+            p.marge = atof(val);
+        } else if (est_option(arg, "-e", "--ecart")) {
+            p.tolerance = atof(val);
+        } else if (est_option(arg, "-E", "--enregistrer")) {
+            p.enregistrer = (strcmp(val, "oui") == 0);
+        } else {
+            fprintf(stderr, "Option inconnue : %s\n", arg);
+            return 1;
+        }
+    }
+    if (p.repetitions < 1) p.repetitions = 1;
+    if (p.puissance < 1) p.puissance = 1;
+
+    // Vérification des noyaux : rapport sur la sortie standard, pas de fichier de résultats
+    if (p.reference != NULL) {
+        return (verifier_noyaux(&p) == 0) ? 0 : 1;
+    }
+
+    FILE *out = fopen(p.sortie, "w");
+    if (out == NULL) {
+        perror("Impossible de creer le fichier de resultats");
+        return 1;
+    }
+    if (p.csv) {
+        fprintf(out, "generateur,n,aretes,etape,repetitions,min_s,moy_s,max_s\n");
+    }
+
+    for (int t = 0; t < GEN_NB; t++) {
+        if (!(p.generateurs & (1u << t))) continue;
+        for (int k = 0; k < p.nb_tailles; k++) {
+            fprintf(stderr, "[bench] %s n=%d\n", nom_generateur(t), p.tailles[k]);
+            mesurer_chaine(out, &p, t, p.tailles[k]);
+        }
+    }
+
+    fclose(out);
+    fprintf(stderr, "[bench] resultats ecrits dans %s\n", p.sortie);
+    return 0;
+}
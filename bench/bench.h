@@ -0,0 +1,45 @@
+#ifndef __BENCH_H__
+#define __BENCH_H__
+#include "matrix.h"
+#include "renumerotation.h"
+
+#define MAX_TAILLES 32
+
+/** Paramètres du benchmark:
+- Générateurs à utiliser (masque de bits sur t_type_generateur)
+- Tailles des chaînes
+- Degré des générateurs, graine, nombre de répétitions
+- Taille maximale pour les étapes denses (N x N)
+- Puissance n pour M^n et la propagation
+- Ordre de renumérotation des étapes "renumerotees"
+- Nombre de threads de l'analyse des classes (0 : un par processeur)
+- Fichier et format des résultats
+- Vérification des noyaux : fichier des temps de référence (NULL : benchmark seul), ralentissement
+  toléré en pourcentage, écart numérique toléré et réécriture des temps de référence
+**/
+typedef struct {
+    unsigned int generateurs;
+    int tailles[MAX_TAILLES];
+    int nb_tailles;
+    int degre;
+    unsigned long long graine;
+    int repetitions;
+    int dense_max;
+    int puissance;
+    t_ordre ordre;
+    int nb_threads;
+    const char *sortie;
+    int csv;
+    const char *reference;
+    double marge;
+    double tolerance;
+    int enregistrer;
+} t_params_bench;
+
+
+//*******PROTOTYPES*******/
+
+t_matrix* puissance_naive(t_matrix *M, int n);
+int verifier_noyaux(const t_params_bench *p);
+
+#endif
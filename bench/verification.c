@@ -0,0 +1,448 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "bench.h"
+#include "list.h"
+#include "tarjan.h"
+#include "hasse.h"
+#include "matrix.h"
+#include "propagation.h"
+#include "periode.h"
+#include "generateur.h"
+#include "instrum.h"
+#include "erreurs.h"
+#include "tuiles.h"
+#include "compression.h"
+#include "renumerotation.h"
+#include "analyse_classes.h"
+
+/* Vérification différentielle des noyaux optimisés : sur chaque chaîne générée,
+ * chaque noyau est comparé au calcul de référence (multiplication_matrice,
+ * getPeriod, removeTransitiveLinks, tarjan_calculer_partition), puis son
+ * meilleur temps est comparé au temps enregistré dans le fichier de référence.
+ * Un désaccord au-delà de la tolérance ou un ralentissement au-delà de la
+ * marge fait échouer la vérification.
+ */
+
+#define FICHIER_TUILES_VERIF "verif_tuiles_tmp.bin"
+#define FICHIER_PRODUIT_VERIF "verif_produit_tmp.bin"
+// En dessous de cet écart absolu (secondes), un ralentissement est du bruit de mesure
+#define ECART_TEMPS_MIN 5e-4
+#define LONGUEUR_NOM 32
+
+/** Temps de référence d'un noyau sur une chaîne:
+- Générateur et taille de la chaîne
+- Nom du noyau
+- Meilleur temps enregistré (secondes)
+**/
+typedef struct {
+    char generateur[LONGUEUR_NOM];
+    int n;
+    char noyau[LONGUEUR_NOM];
+    double temps;
+} t_temps_reference;
+
+// Tableau dynamique des temps de référence (modifie : à réécrire à la fin)
+typedef struct {
+    t_temps_reference *entrees;
+    int nb;
+    int capacite;
+    int modifie;
+} t_references;
+
+/** Vérification en cours:
+- Paramètres et temps de référence
+- Chaîne vérifiée (générateur, taille)
+- Nombre de comparaisons et d'échecs (désaccords et ralentissements)
+**/
+typedef struct {
+    const t_params_bench *p;
+    t_references *refs;
+    const char *gen;
+    int n;
+    int nb_verifications;
+    int nb_echecs;
+} t_verification;
+
+// Lit le fichier "generateur n noyau temps" (lignes # ignorées) ; un fichier absent donne une référence vide
+static int charger_references(const char *chemin, t_references *refs) {
+    memset(refs, 0, sizeof(t_references));
+    FILE *f = fopen(chemin, "r");
+    if (f == NULL) return MARKOV_OK;
+
+    char ligne[256];
+    while (fgets(ligne, sizeof(ligne), f) != NULL) {
+        t_temps_reference e;
+        if (ligne[0] == '#') continue;
+        if (sscanf(ligne, "%31s %d %31s %lf", e.generateur, &e.n, e.noyau, &e.temps) != 4) continue;
+        if (refs->nb >= refs->capacite) {
+            refs->capacite = refs->capacite ? 2 * refs->capacite : 32;
+            refs->entrees = realloc(refs->entrees, refs->capacite * sizeof(t_temps_reference));
+        }
+        refs->entrees[refs->nb++] = e;
+    }
+    fclose(f);
+    return MARKOV_OK;
+}
+
+static int ecrire_references(const char *chemin, const t_references *refs) {
+    FILE *f = fopen(chemin, "w");
+    if (f == NULL) return MARKOV_ERR_FICHIER;
+    fprintf(f, "# generateur n noyau temps_s\n");
+    for (int k = 0; k < refs->nb; k++) {
+        const t_temps_reference *e = &refs->entrees[k];
+        fprintf(f, "%s %d %s %.9f\n", e->generateur, e->n, e->noyau, e->temps);
+    }
+    return (fclose(f) == 0) ? MARKOV_OK : MARKOV_ERR_FICHIER;
+}
+
+static t_temps_reference* chercher_reference(t_references *refs, const char *gen, int n, const char *noyau) {
+    for (int k = 0; k < refs->nb; k++) {
+        t_temps_reference *e = &refs->entrees[k];
+        if (e->n == n && strcmp(e->generateur, gen) == 0 && strcmp(e->noyau, noyau) == 0) return e;
+    }
+    return NULL;
+}
+
+// Enregistre (ou remplace) le temps de référence d'un noyau
+static void enregistrer_reference(t_references *refs, const char *gen, int n, const char *noyau, double temps) {
+    t_temps_reference *e = chercher_reference(refs, gen, n, noyau);
+    if (e == NULL) {
+        if (refs->nb >= refs->capacite) {
+            refs->capacite = refs->capacite ? 2 * refs->capacite : 32;
+            refs->entrees = realloc(refs->entrees, refs->capacite * sizeof(t_temps_reference));
+        }
+        e = &refs->entrees[refs->nb++];
+        snprintf(e->generateur, LONGUEUR_NOM, "%s", gen);
+        e->n = n;
+        snprintf(e->noyau, LONGUEUR_NOM, "%s", noyau);
+    }
+    e->temps = temps;
+    refs->modifie = 1;
+}
+
+//Fonction qui conclut la comparaison d'un noyau : accord avec la référence (écart <= tolérance), puis
+//temps comparé au temps enregistré (absent ou réécriture demandée : le temps mesuré est enregistré)
+static void conclure(t_verification *v, const char *noyau, double ecart, double t_reference, double t_optimise) {
+    const t_params_bench *p = v->p;
+    t_temps_reference *base = chercher_reference(v->refs, v->gen, v->n, noyau);
+    double t_base = (base != NULL) ? base->temps : -1.0;
+    const char *etat = "OK";
+
+    if (!(ecart <= p->tolerance)) {
+        etat = "DESACCORD";
+        v->nb_echecs++;
+    } else if (base == NULL || p->enregistrer) {
+        etat = "ENREGISTRE";
+        enregistrer_reference(v->refs, v->gen, v->n, noyau, t_optimise);
+    } else if (t_optimise > t_base * (1.0 + p->marge / 100.0) && t_optimise - t_base > ECART_TEMPS_MIN) {
+        etat = "RALENTI";
+        v->nb_echecs++;
+    }
+    v->nb_verifications++;
+
+    printf("%-14s n=%-6d %-20s ecart %.2e  optimise %.6f s  reference %.6f s (x%.1f)",
+           v->gen, v->n, noyau, ecart, t_optimise, t_reference,
+           (t_optimise > 0.0) ? t_reference / t_optimise : 0.0);
+    if (t_base >= 0.0) printf("  base %.6f s", t_base);
+    printf("  %s\n", etat);
+}
+
+// Plus grand écart entre deux matrices (infini si leurs tailles diffèrent)
+static double ecart_matrices(const t_matrix *A, const t_matrix *B) {
+    if (A == NULL || B == NULL || A->lignes != B->lignes || A->cols != B->cols) return INFINITY;
+    double ecart = 0.0;
+    for (int i = 0; i < A->lignes; i++) {
+        for (int j = 0; j < A->cols; j++) {
+            double d = fabs(A->data[i][j] - B->data[i][j]);
+            if (!(d <= ecart)) ecart = d;
+        }
+    }
+    return ecart;
+}
+
+//Fonction qui compare deux partitions : 0 si elles ont les mêmes classes (dans le même ordre si
+//meme_ordre, les numéros de classes pouvant sinon différer), 1 sinon
+static double ecart_partitions(t_partition *a, t_partition *b, int n, int meme_ordre) {
+    if (a == NULL || b == NULL || a->taille != b->taille) return 1.0;
+    int *ca = creer_tab_corresp(a, n);
+    int *cb = creer_tab_corresp(b, n);
+    int *image = malloc((a->taille > 0 ? a->taille : 1) * sizeof(int));
+    char *prise = calloc(a->taille > 0 ? a->taille : 1, sizeof(char));
+    for (int c = 0; c < a->taille; c++) image[c] = -1;
+
+    // Chaque classe de a doit correspondre à une seule classe de b, et deux classes à deux classes
+    double ecart = 0.0;
+    for (int v = 0; v < n && ecart == 0.0; v++) {
+        if (image[ca[v]] < 0) {
+            if (prise[cb[v]] || (meme_ordre && cb[v] != ca[v])) ecart = 1.0;
+            image[ca[v]] = cb[v];
+            prise[cb[v]] = 1;
+        } else if (image[ca[v]] != cb[v]) {
+            ecart = 1.0;
+        }
+    }
+
+    free(prise);
+    free(image);
+    free(cb);
+    free(ca);
+    return ecart;
+}
+
+static t_link_array* copier_liens(const t_link_array *liens) {
+    t_link_array *copie = creer_list_link(liens->log_size);
+    memcpy(copie->links, liens->links, liens->log_size * sizeof(t_link));
+    copie->log_size = liens->log_size;
+    return copie;
+}
+
+static void liberer_liens(t_link_array *liens) {
+    free(liens->links);
+    free(liens);
+}
+
+// Nombre de liens différents (même ordre attendu), plus la différence de tailles
+static double ecart_liens(const t_link_array *a, const t_link_array *b) {
+    int nb = (a->log_size < b->log_size) ? a->log_size : b->log_size;
+    int ecart = abs(a->log_size - b->log_size);
+    for (int l = 0; l < nb; l++) {
+        if (a->links[l].from != b->links[l].from || a->links[l].to != b->links[l].to) ecart++;
+    }
+    return ecart;
+}
+
+// Noyaux sur le graphe : classes (Tarjan compressé, Tarjan renuméroté) et diagramme de Hasse
+static void verifier_graphe(t_verification *v, listeAdj *g, t_partition *partition, double t_tarjan) {
+    const t_params_bench *p = v->p;
+    int n = g->nb_sommets;
+
+    // Tarjan itératif sur le graphe compressé : même partition, même numérotation
+    t_graphe_compresse *gc = compresser_graphe(g, COMPRESSION_EXACTE);
+    t_partition *classes = NULL;
+    double t_opt = INFINITY;
+    for (int r = 0; r < p->repetitions; r++) {
+        liberer_partition(classes);
+        double t0 = horloge_monotone();
+        classes = compresse_partition(gc);
+        double t = horloge_monotone() - t0;
+        if (t < t_opt) t_opt = t;
+    }
+    conclure(v, "tarjan_compresse", ecart_partitions(partition, classes, n, 1), t_tarjan, t_opt);
+    liberer_partition(classes);
+    liberer_graphe_compresse(gc);
+
+    // Tarjan sur le graphe renuméroté : mêmes classes, numérotées autrement
+    t_permutation *perm = calculer_permutation(g, partition, p->ordre);
+    listeAdj gp = permuter_graphe(g, perm);
+    classes = NULL;
+    t_opt = INFINITY;
+    for (int r = 0; r < p->repetitions; r++) {
+        liberer_partition(classes);
+        double t0 = horloge_monotone();
+        classes = tarjan_calculer_partition(gp);
+        restaurer_partition(classes, perm);
+        double t = horloge_monotone() - t0;
+        if (t < t_opt) t_opt = t;
+    }
+    conclure(v, "tarjan_renumerote", ecart_partitions(partition, classes, n, 0), t_tarjan, t_opt);
+    liberer_partition(classes);
+    liberer_listeAdj(&gp);
+    liberer_permutation(perm);
+
+    // Suppression des liens transitifs : mêmes liens retirés, même ordre final
+    int *corresp = creer_tab_corresp(partition, n);
+    t_link_array *liens = rencenser(g, corresp);
+    t_link_array *reference = copier_liens(liens);
+    double t0 = horloge_monotone();
+    removeTransitiveLinks(reference);
+    double t_ref = horloge_monotone() - t0;
+
+    t_link_array *optimise = NULL;
+    t_opt = INFINITY;
+    for (int r = 0; r < p->repetitions; r++) {
+        if (optimise != NULL) liberer_liens(optimise);
+        optimise = copier_liens(liens);
+        t0 = horloge_monotone();
+        supprimer_liens_transitifs(optimise);
+        double t = horloge_monotone() - t0;
+        if (t < t_opt) t_opt = t;
+    }
+    conclure(v, "liens_transitifs", ecart_liens(reference, optimise), t_ref, t_opt);
+    liberer_liens(optimise);
+    liberer_liens(reference);
+    liberer_liens(liens);
+    free(corresp);
+}
+
+// Noyaux denses (N x N) : produits, puissances et périodes des classes
+static void verifier_dense(t_verification *v, listeAdj *g, t_partition *partition) {
+    const t_params_bench *p = v->p;
+    int n = g->nb_sommets;
+    t_matrix *M = creer_matrice_liste_adjacence(g);
+
+    // Produit de référence M x M
+    double t0 = horloge_monotone();
+    t_matrix *M2 = multiplication_matrice(M, M);
+    double t_ref = horloge_monotone() - t0;
+
+    // Produit par une vue couvrant toute la matrice
+    t_vue_matrice complete = {M, NULL, NULL, n, n, 1};
+    t_matrix *produit = NULL;
+    double t_opt = INFINITY;
+    for (int r = 0; r < p->repetitions; r++) {
+        liberer_matrice(produit);
+        t0 = horloge_monotone();
+        produit = multiplication_vue(&complete, M);
+        double t = horloge_monotone() - t0;
+        if (t < t_opt) t_opt = t;
+    }
+    conclure(v, "produit_vue", ecart_matrices(M2, produit), t_ref, t_opt);
+    liberer_matrice(produit);
+
+    // Produit hors mémoire par tuiles
+    int taille_tuile = ((n + MULTIPLE_TUILE - 1) / MULTIPLE_TUILE) * MULTIPLE_TUILE;
+    if (taille_tuile > TAILLE_TUILE_DEFAUT) taille_tuile = TAILLE_TUILE_DEFAUT;
+    t_matrice_tuiles *Mt = tuiles_depuis_liste(g, FICHIER_TUILES_VERIF, taille_tuile);
+    if (Mt != NULL) {
+        t_matrice_tuiles *Pt = NULL;
+        t_opt = INFINITY;
+        for (int r = 0; r < p->repetitions; r++) {
+            if (Pt != NULL) liberer_matrice_tuiles(Pt, 1);
+            t0 = horloge_monotone();
+            Pt = multiplication_tuiles(Mt, Mt, FICHIER_PRODUIT_VERIF);
+            double t = horloge_monotone() - t0;
+            if (t < t_opt) t_opt = t;
+        }
+        produit = (Pt != NULL) ? tuiles_vers_matrice(Pt) : NULL;
+        conclure(v, "produit_tuiles", ecart_matrices(M2, produit), t_ref, t_opt);
+        liberer_matrice(produit);
+        if (Pt != NULL) liberer_matrice_tuiles(Pt, 1);
+        liberer_matrice_tuiles(Mt, 1);
+    }
+    liberer_matrice(M2);
+
+    // M^n : multiplications successives contre propagation creuse des N lignes de l'identité
+    t0 = horloge_monotone();
+    t_matrix *Mn = puissance_naive(M, p->puissance);
+    t_ref = horloge_monotone() - t0;
+    t_matrix *identite = creer_matrice_valzeros(n, n);
+    for (int i = 0; i < n; i++) identite->data[i][i] = 1.0;
+    t_matrix *propage = NULL;
+    t_opt = INFINITY;
+    for (int r = 0; r < p->repetitions; r++) {
+        liberer_matrice(propage);
+        t0 = horloge_monotone();
+        propage = propager_distributions(g, identite, p->puissance);
+        double t = horloge_monotone() - t0;
+        if (t < t_opt) t_opt = t;
+    }
+    conclure(v, "propagation", ecart_matrices(Mn, propage), t_ref, t_opt);
+    liberer_matrice(propage);
+    liberer_matrice(identite);
+    liberer_matrice(Mn);
+
+    // Périodes de référence : getPeriod sur chaque sous-matrice copiée
+    int nb = partition->taille;
+    int *periodes_ref = malloc((nb > 0 ? nb : 1) * sizeof(int));
+    int *periodes = malloc((nb > 0 ? nb : 1) * sizeof(int));
+    t0 = horloge_monotone();
+    for (int c = 0; c < nb; c++) {
+        t_matrix *sous = extractSquareSubMatrix(M, partition, c);
+        periodes_ref[c] = getPeriod(sous);
+        liberer_matrice(sous);
+    }
+    t_ref = horloge_monotone() - t0;
+
+    // Sur des vues de M
+    t_opt = INFINITY;
+    for (int r = 0; r < p->repetitions; r++) {
+        t0 = horloge_monotone();
+        for (int c = 0; c < nb; c++) {
+            t_vue_matrice vue;
+            periodes[c] = (vue_sous_matrice_carree(M, partition, c, &vue) == MARKOV_OK) ? vue_periode(&vue) : -1;
+        }
+        double t = horloge_monotone() - t0;
+        if (t < t_opt) t_opt = t;
+    }
+    int differentes = 0;
+    for (int c = 0; c < nb; c++) differentes += (periodes[c] != periodes_ref[c]);
+    conclure(v, "periode_vue", differentes, t_ref, t_opt);
+
+    // Par parcours en largeur du graphe
+    t_opt = INFINITY;
+    for (int r = 0; r < p->repetitions; r++) {
+        t0 = horloge_monotone();
+        calculer_periodes(g, partition, periodes, NULL);
+        double t = horloge_monotone() - t0;
+        if (t < t_opt) t_opt = t;
+    }
+    differentes = 0;
+    for (int c = 0; c < nb; c++) differentes += (periodes[c] != periodes_ref[c]);
+    conclure(v, "periode_largeur", differentes, t_ref, t_opt);
+
+    // Par l'analyse parallèle des classes
+    t_analyse_classes *analyses = NULL;
+    t_opt = INFINITY;
+    for (int r = 0; r < p->repetitions; r++) {
+        liberer_analyse_classes(analyses);
+        t0 = horloge_monotone();
+        analyses = analyser_classes(g, partition, 1e-9, 1000, p->nb_threads);
+        double t = horloge_monotone() - t0;
+        if (t < t_opt) t_opt = t;
+    }
+    // Échec d'allocation de l'analyse : toutes les classes comptent comme différentes
+    differentes = (analyses == NULL) ? nb : 0;
+    for (int c = 0; analyses != NULL && c < nb; c++) differentes += (analyses->classes[c].periode != periodes_ref[c]);
+    conclure(v, "classes_paralleles", differentes, t_ref, t_opt);
+    liberer_analyse_classes(analyses);
+
+    free(periodes);
+    free(periodes_ref);
+    liberer_matrice(M);
+}
+
+//Fonction qui vérifie tous les noyaux sur les chaînes demandées et met à jour le fichier de référence
+//(temps nouveaux ou réécriture demandée). Renvoie le nombre d'échecs, -1 si la référence n'est pas écrite
+int verifier_noyaux(const t_params_bench *p) {
+    t_references refs;
+    charger_references(p->reference, &refs);
+
+    t_verification v;
+    v.p = p;
+    v.refs = &refs;
+    v.nb_verifications = 0;
+    v.nb_echecs = 0;
+
+    for (int t = 0; t < GEN_NB; t++) {
+        if (!(p->generateurs & (1u << t))) continue;
+        for (int k = 0; k < p->nb_tailles; k++) {
+            listeAdj g = generer_chaine(t, p->tailles[k], p->degre, p->graine);
+            v.gen = nom_generateur(t);
+            v.n = g.nb_sommets;
+
+            double t0 = horloge_monotone();
+            t_partition *partition = tarjan_calculer_partition(g);
+            double t_tarjan = horloge_monotone() - t0;
+
+            verifier_graphe(&v, &g, partition, t_tarjan);
+            if (v.n <= p->dense_max) verifier_dense(&v, &g, partition);
+
+            liberer_partition(partition);
+            liberer_listeAdj(&g);
+        }
+    }
+
+    int code = MARKOV_OK;
+    if (refs.modifie) code = ecrire_references(p->reference, &refs);
+    free(refs.entrees);
+
+    printf("%d verifications, %d echec(s) (tolerance %.1e, marge %.0f %%)\n",
+           v.nb_verifications, v.nb_echecs, p->tolerance, p->marge);
+    if (code != MARKOV_OK) {
+        fprintf(stderr, "Impossible d'ecrire les temps de reference dans %s\n", p->reference);
+        return -1;
+    }
+    return v.nb_echecs;
+}
@@ -0,0 +1,31 @@
+#ifndef __ABSORPTION_H__
+#define __ABSORPTION_H__
+#include "list.h"
+#include "tarjan.h"
+
+/** Résultat du calcul d'absorption (chaîne découpée par Tarjan):
+- Nombre de sommets du graphe
+- Nombre de classes persistantes et leurs indices dans la partition
+- Pour chaque classe de la partition, son rang parmi les persistantes (-1 si transitoire)
+- proba[i * nb_persistantes + k] : probabilité que le sommet i+1 finisse dans la k-ième classe persistante
+- temps[i] : nombre moyen de pas avant d'entrer dans une classe persistante (0 si déjà persistant)
+- Nombre total de balayages de Gauss-Seidel et plus grand écart du dernier balayage
+**/
+typedef struct {
+    int nb_sommets;
+    int nb_persistantes;
+    int *classes_persistantes;
+    int *rang_persistante;
+    double *proba;
+    double *temps;
+    int iterations;
+    double residu;
+} t_absorption;
+
+
+//*******PROTOTYPES*******/
+
+t_absorption* calculer_absorption(listeAdj *g, t_partition *partition, double epsilon, int max_iter);
+void liberer_absorption(t_absorption *abs);
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef __AFFICHAGE_H__
+#define __AFFICHAGE_H__
+#include "list.h"
+#include "tarjan.h"
+#include "hasse.h"
+#include "matrix.h"
+#include "absorption.h"
+
+//*******PROTOTYPES*******/
+
+void displayListe(liste l);
+void displayListeAdj(listeAdj g);
+int afficherVerificationMarkov(const t_validation *v);
+void afficher_matrice(t_matrix* matrice);
+void afficher_vue(const t_vue_matrice *vue);
+void afficher_partition(t_partition *partition);
+void afficher_composantes(t_partition *partition);
+void analyserCarac(t_partition *partition, listeAdj *g);
+void afficher_absorption(t_absorption *abs, t_partition *partition);
+
+#endif
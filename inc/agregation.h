@@ -0,0 +1,38 @@
+#ifndef __AGREGATION_H__
+#define __AGREGATION_H__
+#include "list.h"
+#include "tarjan.h"
+#include "matrix.h"
+
+/** Agrégation d'une chaîne par blocs d'états de même ligne (M = A R, A : bloc de chaque état,
+R : ligne commune de chaque bloc), relevée exactement sur les états d'origine:
+- Nombre d'états de la chaîne d'origine et nombre de blocs
+- bloc[i] : bloc (indice C) de l'état i+1
+- debut[b]..debut[b+1]-1 : indices dans membres des états (1 à N) du bloc b
+- Tolérance utilisée (0 : lignes identiques) ; les probabilités étant arrondies à une grille de pas
+  tolérance, deux états à moins de la tolérance l'un de l'autre peuvent rester dans des blocs
+  différents (voir agregation.c)
+- ecart : plus grand écart (norme 1) entre la ligne d'un état et celle de son bloc (0 si exacte)
+- lignes : ligne commune de chaque bloc sur les états d'origine (moyenne des lignes du bloc)
+- quotient : chaîne agrégée R A (un sommet par bloc)
+**/
+typedef struct {
+    int nb_sommets;
+    int nb_blocs;
+    int *bloc;
+    int *debut;
+    int *membres;
+    double tolerance;
+    double ecart;
+    listeAdj lignes;
+    listeAdj quotient;
+} t_agregation;
+
+
+//*******PROTOTYPES*******/
+
+t_agregation* agreger_chaine(listeAdj *g, t_partition *partition, double tolerance);
+t_matrix* agregation_relever(t_agregation *agr, t_matrix *limite_quotient);
+void liberer_agregation(t_agregation *agr);
+
+#endif
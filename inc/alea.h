@@ -0,0 +1,17 @@
+#ifndef __ALEA_H__
+#define __ALEA_H__
+
+/* Générateur aléatoire à compteur : la valeur tirée ne dépend que de
+ * (clé, compteur), jamais d'un état partagé. Chaque marche a sa propre clé
+ * et le numéro du pas sert de compteur : les résultats sont identiques quel
+ * que soit le nombre de threads ou l'ordre d'exécution.
+ */
+
+//*******PROTOTYPES*******/
+
+unsigned long long alea_melanger(unsigned long long x);
+unsigned long long alea_cle(unsigned long long graine, unsigned long long flux);
+unsigned long long alea_compteur(unsigned long long cle, unsigned long long compteur);
+double alea_uniforme(unsigned long long cle, unsigned long long compteur);
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef __ALIAS_H__
+#define __ALIAS_H__
+#include "list.h"
+#include "creuse.h"
+
+/** Case d'une table d'alias de Walker (une case par arête):
+- seuil : probabilité de garder la case
+- arrivee : sommet d'arrivée de la case (indice C)
+- alias : sommet d'arrivée si la case est refusée (indice C)
+**/
+typedef struct {
+    double seuil;
+    int arrivee;
+    int alias;
+} t_case_alias;
+
+/** Tables d'alias de tous les sommets, rangées à la suite:
+- debut[i]..debut[i+1]-1 : cases du sommet i+1
+- cases : tableau contigu des nb_aretes cases
+**/
+typedef struct {
+    int nb_sommets;
+    int nb_aretes;
+    int *debut;
+    t_case_alias *cases;
+} t_alias;
+
+
+//*******PROTOTYPES*******/
+
+t_alias* creer_alias(listeAdj *g);
+t_alias* creer_alias_csr(const t_csr *csr);
+int alias_tirer(const t_alias *tables, int sommet, double u);
+void liberer_alias(t_alias *tables);
+
+#endif
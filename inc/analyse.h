@@ -0,0 +1,83 @@
+#ifndef __ANALYSE_H__
+#define __ANALYSE_H__
+#include <stdio.h>
+#include "instrum.h"
+#include "sortie.h"
+#include "compression.h"
+#include "renumerotation.h"
+
+// Étapes de l'analyse (combinables avec |)
+#define ETAPE_VERIF        (1u << 0)
+#define ETAPE_MERMAID      (1u << 1)
+#define ETAPE_TARJAN       (1u << 2)
+#define ETAPE_HASSE        (1u << 3)
+#define ETAPE_CARAC        (1u << 4)
+#define ETAPE_ABSORPTION   (1u << 5)
+#define ETAPE_PUISSANCE    (1u << 6)
+#define ETAPE_CONVERGENCE  (1u << 7)
+#define ETAPE_PERIODE      (1u << 8)
+#define ETAPE_TOUTES       ((1u << 9) - 1)
+
+// Étapes coûteuses hors de "tout", à demander explicitement
+#define ETAPE_SIMULATION   (1u << 9)
+#define ETAPE_SPECTRE      (1u << 10)
+
+// Nombre maximal d'horizons n demandés en une fois (-n 10,100,1000)
+#define MAX_PUISSANCES 32
+
+// Au-delà de ce nombre d'arêtes, le graphe Mermaid est réduit au graphe des classes
+#define SEUIL_CONDENSATION_MERMAID 20000
+
+/** Paramètres d'une analyse non interactive:
+- Fichier de la chaîne, ou dossier dont on traite toutes les chaînes
+- Fichier des distributions initiales (une distribution de N valeurs par ligne)
+- Dossier de sortie (par défaut : celui de la chaîne)
+- Puissances n (un ou plusieurs horizons), epsilon de la convergence et nombre maximal d'itérations par classe
+  de la limite (0 : déduit du trou spectral)
+- Budget du cache des puissances en Mo (0 : pas de cache)
+- Intervalle en secondes des points de reprise de la propagation (négatif : pas de reprise)
+- Étapes à exécuter et nombre de threads pour le mode dossier
+- Fichier JSON du profil (temps et mémoire par étape), NULL pour ne pas mesurer
+- Simulation : nombre de marches, nombre de pas et graine
+- Estimation : fichier de séquences d'états ("-" pour l'entrée standard) et fichier de la chaîne estimée
+- Format (texte, JSON, CSV) et niveau de verbosité des rapports
+- Tolérance de l'agrégation des états avant la matrice (négative : pas d'agrégation, 0 : exacte)
+- Stockage compressé du graphe pour la partition et la propagation (COMPRESSION_AUCUNE : listes)
+- Renumérotation des états pour la propagation (ORDRE_ORIGINE : numéros du fichier)
+- Validation à la lecture : tolérance sur la somme sortante de chaque sommet et renormalisation des lignes
+**/
+typedef struct {
+    const char *entree;
+    const char *dossier;
+    const char *fichier_init;
+    const char *sortie;
+    int puissances[MAX_PUISSANCES];
+    int nb_puissances;
+    long long cache_mo;
+    double reprise;
+    double epsilon;
+    int max_iter;
+    unsigned int etapes;
+    int nb_threads;
+    const char *profil;
+    long long nb_marches;
+    int horizon;
+    unsigned long long graine;
+    const char *sequences;
+    const char *chaine_estimee;
+    t_format_sortie format;
+    t_niveau niveau;
+    double agregation;
+    t_mode_compression compression;
+    t_ordre ordre;
+    double tolerance;
+    int renormaliser;
+} t_options;
+
+
+//*******PROTOTYPES*******/
+
+void options_par_defaut(t_options *opt);
+int analyser_chaine(const char *chemin, const t_options *opt, t_sortie *sortie, t_profil *profil);
+
+#endif
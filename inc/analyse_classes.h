@@ -0,0 +1,45 @@
+#ifndef __ANALYSE_CLASSES_H__
+#define __ANALYSE_CLASSES_H__
+#include "list.h"
+#include "tarjan.h"
+
+/** Analyse d'une classe, calculée sur le graphe (sans matrice dense):
+- Période de la classe (-1 en cas d'erreur)
+- Classe persistante (aucune arête ne sort de la classe) ou transitoire
+- Loi stationnaire de la classe dans l'ordre de ses sommets (NULL si transitoire), nombre
+  d'itérations et écart final entre les deux dernières itérations
+- Statistiques de la sous-matrice : arêtes internes et sortantes, masse moyenne restant dans
+  la classe en un pas et masse sortante maximale d'une ligne
+**/
+typedef struct {
+    int periode;
+    int persistante;
+    double *stationnaire;
+    int iterations;
+    double residu;
+    long long aretes_internes;
+    long long aretes_sortantes;
+    double masse_interne;
+    double masse_sortante_max;
+} t_analyse_classe;
+
+/** Analyses de toutes les classes d'une partition:
+- Nombre de classes ; classes[c] est l'analyse de la classe c, quel que soit le thread qui l'a
+  calculée : le résultat ne dépend ni du nombre de threads ni de l'ordre d'exécution
+- Nombre de threads utilisés et nombre de tâches prises à un autre thread (équilibrage)
+**/
+typedef struct {
+    int nb_classes;
+    t_analyse_classe *classes;
+    int nb_threads;
+    int nb_vols;
+} t_analyse_classes;
+
+
+//*******PROTOTYPES*******/
+
+t_analyse_classes* analyser_classes(listeAdj *g, t_partition *partition, double epsilon, int max_iter, int nb_threads);
+void liberer_analyse_classes(t_analyse_classes *res);
+int nb_processeurs(void);
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef __CACHE_PUISSANCES_H__
+#define __CACHE_PUISSANCES_H__
+#include <stddef.h>
+#include "list.h"
+#include "matrix.h"
+#include "creuse.h"
+
+// Nombre maximal de carrés successifs : M^(2^0) à M^(2^30) couvrent tout n de type int
+#define CACHE_MAX_NIVEAUX 31
+
+// Au-dessous de cette densité, une puissance est gardée au format creux
+#define CACHE_DENSITE_CREUSE 0.25
+
+/** Puissance M^(2^i) gardée en cache, au format dense ou creux selon sa densité:
+- dense / creuse : une seule des deux est non NULL (les deux NULL : pas en cache)
+- octets : place occupée en mémoire
+- utilisation : date du dernier accès (horloge logique du cache, pour l'éviction LRU)
+**/
+typedef struct {
+    t_matrix *dense;
+    t_csr *creuse;
+    size_t octets;
+    unsigned long long utilisation;
+} t_puissance;
+
+/** Cache des carrés successifs de la matrice de transition:
+- Nombre de sommets et signature de la chaîne (pour ne recharger que les puissances de la même chaîne)
+- niveaux[i] : M^(2^i), niveaux[0] = M n'est jamais évincé
+- Budget mémoire (octets) et place occupée
+- Horloge logique et statistiques (puissances trouvées, calculées, évincées)
+**/
+typedef struct {
+    int nb_sommets;
+    unsigned long long signature;
+    t_puissance niveaux[CACHE_MAX_NIVEAUX];
+    size_t budget;
+    size_t occupe;
+    unsigned long long horloge;
+    long long trouvees;
+    long long calculees;
+    long long evincees;
+} t_cache_puissances;
+
+
+//*******PROTOTYPES*******/
+
+t_cache_puissances* creer_cache_puissances(listeAdj *g, size_t budget_octets);
+t_matrix* cache_puissance(t_cache_puissances *cache, int n);
+t_matrix* cache_propager(t_cache_puissances *cache, t_matrix *init, int n);
+int cache_sauvegarder(t_cache_puissances *cache, const char *nomFichier);
+int cache_charger(t_cache_puissances *cache, const char *nomFichier);
+void liberer_cache_puissances(t_cache_puissances *cache);
+
+#endif
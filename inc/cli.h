@@ -0,0 +1,13 @@
+#ifndef __CLI_H__
+#define __CLI_H__
+#include "analyse.h"
+
+//*******PROTOTYPES*******/
+
+void afficher_aide(const char *prog);
+int parser_options(int argc, char **argv, t_options *opt);
+int executer_cli(const t_options *opt);
+int traiter_dossier(const t_options *opt);
+int estimer_chaine(const t_options *opt);
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef __COMPRESSION_H__
+#define __COMPRESSION_H__
+#include <stddef.h>
+#include "list.h"
+#include "tarjan.h"
+
+// Probabilité codée sur 16 bits : p = quantum / ECHELLE_QUANTUM (1.0 est représentable)
+#define ECHELLE_QUANTUM 65535
+
+// Stockage des probabilités : float exact (4 octets) ou quantum sur 16 bits
+typedef enum {
+    COMPRESSION_AUCUNE = 0,
+    COMPRESSION_EXACTE = 1,
+    COMPRESSION_QUANTIFIEE = 2
+} t_mode_compression;
+
+/** Graphe compressé : les lignes sont codées à la suite dans un seul flux d'octets:
+- Nombre de sommets et nombre d'arêtes
+- Mode de stockage des probabilités
+- debut[i]..debut[i+1]-1 : octets de la ligne du sommet i+1
+- Chaque arête : écart signé à l'arrivée précédente (la première : au sommet de départ) en
+  varint zigzag, suivi de sa probabilité. L'ordre des listes est conservé, les parcours
+  visitent donc les successeurs dans le même ordre que sur la liste d'adjacence
+- Taille du flux en octets
+En mode quantifié, les quanta d'une ligne sont corrigés pour que leur somme soit
+exactement l'arrondi de la somme d'origine : une ligne stochastique reste stochastique.
+**/
+typedef struct {
+    int nb_sommets;
+    long long nb_aretes;
+    t_mode_compression mode;
+    size_t *debut;
+    unsigned char *octets;
+    size_t taille;
+} t_graphe_compresse;
+
+
+//*******PROTOTYPES*******/
+
+t_graphe_compresse* compresser_graphe(listeAdj *g, t_mode_compression mode);
+void liberer_graphe_compresse(t_graphe_compresse *gc);
+size_t compresse_octets(const t_graphe_compresse *gc);
+int compresse_ligne(const t_graphe_compresse *gc, int i, int *arrivees, double *probas);
+void compresse_propager_vecteur(const t_graphe_compresse *gc, const double *x, double *y);
+void compresse_propager_etape(const t_graphe_compresse *gc, const double *X, double *Y, int K);
+t_partition* compresse_partition(const t_graphe_compresse *gc);
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef __CREUSE_H__
+#define __CREUSE_H__
+#include "list.h"
+
+/** Matrice de transition creuse au format CSR (lignes compressées):
+- Nombre de sommets et nombre d'arêtes
+- debut[i]..debut[i+1]-1 : indices des arêtes sortant du sommet i+1
+- arrivee[e] : sommet d'arrivée de l'arête e (indice C, 0-based)
+- proba[e] : probabilité de l'arête e
+Les trois tableaux sont contigus : un seul parcours mémoire par propagation.
+**/
+typedef struct {
+    int nb_sommets;
+    int nb_aretes;
+    int *debut;
+    int *arrivee;
+    double *proba;
+} t_csr;
+
+
+//*******PROTOTYPES*******/
+
+t_csr* creer_csr(listeAdj *g);
+void liberer_csr(t_csr *csr);
+void csr_propager_vecteur(const t_csr *csr, const double *x, double *y);
+unsigned long long csr_signature(const t_csr *csr);
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef __ERREURS_H__
+#define __ERREURS_H__
+
+/* Codes de retour de la bibliothèque : 0 en cas de succès, négatif sinon.
+ * Aucune fonction de la bibliothèque n'affiche de message ni n'appelle exit :
+ * c'est à l'appelant de décider quoi faire d'une erreur.
+ */
+typedef enum {
+    MARKOV_OK = 0,
+    MARKOV_ERR_FICHIER = -1,     // fichier introuvable ou illisible
+    MARKOV_ERR_FORMAT = -2,      // contenu qui ne respecte pas le format attendu
+    MARKOV_ERR_MEMOIRE = -3,     // allocation impossible
+    MARKOV_ERR_DIMENSIONS = -4,  // matrices ou vecteurs de tailles incompatibles
+    MARKOV_ERR_PARAMETRE = -5    // paramètre invalide
+} t_erreur_markov;
+
+
+//*******PROTOTYPES*******/
+
+const char* markov_message_erreur(int code);
+
+#endif
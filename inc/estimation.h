@@ -0,0 +1,47 @@
+#ifndef __ESTIMATION_H__
+#define __ESTIMATION_H__
+#include <stdio.h>
+#include <pthread.h>
+#include "list.h"
+
+// Nombre de fragments de la table des transitions (puissance de 2)
+#define NB_FRAGMENTS 64
+
+/** Fragment de la table des transitions observées (adressage ouvert):
+- cles[k] : transition (depart << 32 | arrivee), 0 si la case est vide
+- comptes[k] : nombre d'observations de la transition
+- Chaque fragment a son verrou : deux threads ne se bloquent que s'ils écrivent dans le même fragment
+**/
+typedef struct {
+    unsigned long long *cles;
+    unsigned long long *comptes;
+    size_t capacite;
+    size_t nb;
+    pthread_mutex_t verrou;
+    char marge[64];
+} t_fragment;
+
+/** Estimateur d'une chaîne à partir de séquences d'états:
+- Table des transitions découpée en NB_FRAGMENTS fragments
+- Plus grand identifiant d'état rencontré (nombre de sommets de la chaîne estimée)
+- Nombre d'états lus, de transitions comptées et de valeurs invalides ignorées
+**/
+typedef struct {
+    t_fragment fragments[NB_FRAGMENTS];
+    int nb_sommets;
+    unsigned long long nb_observations;
+    unsigned long long nb_transitions;
+    unsigned long long nb_invalides;
+    pthread_mutex_t verrou;
+} t_estimateur;
+
+
+//*******PROTOTYPES*******/
+
+t_estimateur* creer_estimateur(void);
+void estimateur_ajouter(t_estimateur *est, int depart, int arrivee, unsigned long long nb);
+int estimer_flux(t_estimateur *est, FILE *flux, int nb_threads);
+listeAdj estimateur_vers_chaine(t_estimateur *est, int *nb_absorbants, int *nb_absents);
+void liberer_estimateur(t_estimateur *est);
+
+#endif
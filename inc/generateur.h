@@ -0,0 +1,30 @@
+#ifndef __GENERATEUR_H__
+#define __GENERATEUR_H__
+#include "list.h"
+
+/** Familles de chaînes synthétiques (benchmarks et tests de performance):
+- ALEATOIRE : chaque sommet a `degre` successeurs tirés au hasard
+- BANDE : successeurs dans une fenêtre de largeur `degre` autour du sommet
+- ANNEAU : chaîne irréductible de période `degre` (couches parcourues en cycle)
+- PETITES_SCC : beaucoup de petites classes de taille `degre` reliées en DAG
+- CHEMIN : chemin profond 1 -> 2 -> ... -> n, le dernier sommet est absorbant
+- BANDE_MELANGEE : la bande avec des numéros d'états tirés au hasard (voisins dispersés en mémoire)
+**/
+typedef enum {
+    GEN_ALEATOIRE,
+    GEN_BANDE,
+    GEN_ANNEAU,
+    GEN_PETITES_SCC,
+    GEN_CHEMIN,
+    GEN_BANDE_MELANGEE,
+    GEN_NB
+} t_type_generateur;
+
+
+//*******PROTOTYPES*******/
+
+const char* nom_generateur(t_type_generateur type);
+int generateur_depuis_nom(const char *nom);
+listeAdj generer_chaine(t_type_generateur type, int n, int degre, unsigned long long graine);
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef __INSTRUM_H__
+#define __INSTRUM_H__
+#include <stdio.h>
+
+#define PROFIL_MAX_ETAPES 32
+
+/** Mesure d'une étape:
+- Nom de l'étape
+- Début (horloge monotone) et durée en secondes
+- Taille traitée (sommets, arêtes) pour le débit
+- Pic de mémoire résidente du processus à la fin de l'étape (Ko)
+- Variation de la mémoire allouée sur le tas pendant l'étape (octets)
+**/
+typedef struct {
+    char nom[32];
+    double debut;
+    double duree;
+    long long sommets;
+    long long aretes;
+    long rss_pic_ko;
+    long long tas_delta;
+    long long tas_debut;
+} t_mesure_etape;
+
+/** Profil d'une analyse:
+- Nom de la chaîne analysée
+- Mesures des étapes dans l'ordre d'exécution
+- Début de l'analyse (pour la durée totale)
+- Analyse concurrente d'autres chaînes dans le même processus : le pic de mémoire résidente et le
+  tas sont ceux du processus entier, ils ne sont alors pas écrits dans le rapport
+**/
+typedef struct {
+    char nom[256];
+    t_mesure_etape etapes[PROFIL_MAX_ETAPES];
+    int nb_etapes;
+    double debut;
+    int concurrent;
+} t_profil;
+
+/* Mesure une portée : PROFIL_ETAPE(p, "tarjan", n, m) { ... }
+ * Les tailles sont évaluées à la sortie du bloc. Avec p == NULL rien n'est mesuré.
+ * Ne pas sortir du bloc par return/break (la mesure ne serait pas fermée).
+ */
+#define PROFIL_ETAPE(p, nom, sommets, aretes) \
+    for (int _idx_etape = profil_debut((p), (nom)), _une_fois = 1; _une_fois; \
+         _une_fois = 0, profil_fin((p), _idx_etape, (sommets), (aretes)))
+
+
+//*******PROTOTYPES*******/
+
+double horloge_monotone(void);
+long rss_pic_ko(void);
+long long tas_utilise(void);
+
+void profil_init(t_profil *p, const char *nom);
+int profil_debut(t_profil *p, const char *nom);
+void profil_fin(t_profil *p, int idx, long long sommets, long long aretes);
+void profil_ecrire_json(const t_profil *p, FILE *out);
+int profil_sauvegarder_json(const t_profil *profils, int nb, const char *nomFichier);
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef __LIMITE_H__
+#define __LIMITE_H__
+#include "list.h"
+#include "tarjan.h"
+#include "matrix.h"
+#include "absorption.h"
+
+/* Limite de M^k calculée à partir des classes de Tarjan au lieu d'élever la
+ * matrice entière au carré : chaque classe persistante est une petite chaîne
+ * irréductible dont on calcule la loi stationnaire, et les classes
+ * transitoires s'y répartissent selon leurs probabilités d'absorption.
+ * L[i][j] = proba(i absorbé par la classe de j) * pi(j).
+ *
+ * Si une classe persistante a une période d > 1, M^k ne converge pas : L est
+ * alors la limite de Cesàro (moyenne des puissances), et M^(kd + r) converge
+ * vers la limite cyclique de phase r. Pour un sommet transitoire, la phase
+ * d'entrée dans la classe est résolue comme l'absorption, avec d inconnues
+ * par classe périodique au lieu d'une.
+ */
+
+/** Limite (projecteur ergodique) d'une chaîne:
+- Nombre de sommets
+- Probabilités d'absorption des sommets dans chaque classe persistante
+- rang[j] : rang de la classe persistante du sommet j+1 (-1 si transitoire)
+- stationnaire[j] : probabilité de j+1 dans la loi stationnaire de sa classe (0 si transitoire)
+- Période de la chaîne (ppcm des périodes des classes persistantes, 1 si M^k converge)
+- periode_classe[k] : période de la k-ième classe persistante, position[j] : position cyclique de j+1
+- decalage[k] : début des phases de la k-ième classe persistante dans une ligne de phase (-1 si apériodique)
+- phase[i * nb_phases + decalage[k] + a] : probabilité que i+1 entre dans la classe k avec la phase a
+  (position du sommet d'entrée moins l'instant d'entrée, modulo la période)
+- Nombre total d'itérations et plus grand écart restant (absorption, phases et lois stationnaires)
+**/
+typedef struct {
+    int nb_sommets;
+    t_absorption *absorption;
+    int *rang;
+    double *stationnaire;
+    int periode;
+    int *periode_classe;
+    int *position;
+    int *decalage;
+    int nb_phases;
+    double *phase;
+    int iterations;
+    double residu;
+} t_limite;
+
+
+//*******PROTOTYPES*******/
+
+int stationnaire_classe(listeAdj *g, t_classe *classe, double *pi, double *suivant,
+                        double epsilon, int max_iter, double *residu);
+t_limite* calculer_limite(listeAdj *g, t_partition *partition, double epsilon, int max_iter);
+double limite_coefficient(const t_limite *lim, int i, int j);
+t_matrix* limite_matrice(const t_limite *lim);
+double limite_cyclique(const t_limite *lim, int i, int j, int r);
+t_matrix* limite_matrice_cyclique(const t_limite *lim, int r);
+void liberer_limite(t_limite *lim);
+
+#endif
@@ -5,6 +5,11 @@
 #include <stdlib.h>
 #include <string.h>
 
+// Écart toléré par défaut entre 1 et la somme des probabilités sortantes d'un sommet
+#define TOLERANCE_MARKOV 0.01
+// Nombre de sommets fautifs détaillés dans le rapport de validation
+#define VALIDATION_MAX_SIGNALES 16
+
 /**
 Structure d'une cellule (une cellule = une arrête d'un sommet vers un autre):
 - Numéro du sommet d'arrivée
@@ -37,19 +42,41 @@ typedef struct liste_adj{
     int nb_sommets;
 } listeAdj;
 
+/**
+Rapport de la validation faite pendant la lecture (un seul passage sur le fichier):
+- Tolérance sur |somme - 1| et renormalisation des lignes demandée ou non (paramètres)
+- Nombre de sommets hors tolérance et écart maximal |somme - 1| (sommes compensées, en double)
+- Les premiers sommets fautifs (numéros du fichier) avec leur somme lue, au plus VALIDATION_MAX_SIGNALES
+- Nombre de lignes renormalisées (divisées par leur somme)
+- Verdict : chaîne de Markov après l'éventuelle renormalisation (une ligne vide ne l'est jamais)
+**/
+typedef struct {
+    double tolerance;
+    int renormaliser;
+    int nb_invalides;
+    double ecart_max;
+    int signales[VALIDATION_MAX_SIGNALES];
+    double sommes[VALIDATION_MAX_SIGNALES];
+    int nb_signales;
+    int nb_renormalisees;
+    int markov;
+} t_validation;
+
 
 //*******PROTOTYPES*******/
 
 cell *createCell(int arrivee, float probab);
 liste *createListe();
 void addCell(liste *l, int arrivee, float probab);
-void displayListe(liste l);
 listeAdj createListeAdj(int taille);
-void displayListeAdj(listeAdj g);
+void liberer_listeAdj(listeAdj *g);
+void validation_init(t_validation *v, double tolerance, int renormaliser);
+int lireGraphe(const char *filename, listeAdj *g);
+int lireGrapheValide(const char *filename, listeAdj *g, t_validation *v);
 listeAdj readGraph(const char *filename);
+int ecrireGraphe(listeAdj g, const char *filename);
+double sommeSortante(liste l);
 int verifierGrapheMarkov(listeAdj g);
-void genererFichierMermaid(listeAdj g, const char* nomFichier);
-void genererFichierMermaid(listeAdj g, const char* nomFichier);
-int verifierGrapheMarkov(listeAdj g);
+int genererFichierMermaid(listeAdj g, const char* nomFichier);
 
 #endif
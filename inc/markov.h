@@ -0,0 +1,39 @@
+#ifndef __MARKOV_H__
+#define __MARKOV_H__
+
+/* En-tête unique de la bibliothèque libmarkov.
+ * Toutes les fonctions sont réentrantes : pas de variable globale, pas
+ * d'affichage, et les erreurs sont renvoyées sous forme de code (erreurs.h)
+ * ou de pointeur NULL. Plusieurs chaînes peuvent donc être analysées en
+ * parallèle dans un même processus, chacune par son propre thread.
+ */
+
+#include "erreurs.h"
+#include "utils.h"
+#include "list.h"
+#include "tarjan.h"
+#include "hasse.h"
+#include "matrix.h"
+#include "absorption.h"
+#include "creuse.h"
+#include "propagation.h"
+#include "alea.h"
+#include "alias.h"
+#include "simulation.h"
+#include "estimation.h"
+#include "generateur.h"
+#include "instrum.h"
+#include "sortie.h"
+#include "cache_puissances.h"
+#include "periode.h"
+#include "agregation.h"
+#include "limite.h"
+#include "spectre.h"
+#include "reprise.h"
+#include "tuiles.h"
+#include "compression.h"
+#include "renumerotation.h"
+#include "analyse_classes.h"
+#include "mise_a_jour.h"
+
+#endif
@@ -11,21 +11,52 @@ typedef struct {
     int cols; //colonne de la matrice 
 } t_matrix;
 
+/** Vue sur une sous-matrice, sans copie : les lignes et colonnes sont lues dans la matrice parente
+- Matrice parente (la vue ne la possède pas et ne doit pas lui survivre)
+- lignes[i] : numéro dans la parente de la ligne i de la vue (NULL : toutes les lignes, dans l'ordre)
+- cols[j] : numéro de la colonne j (NULL : toutes les colonnes)
+- Nombre de lignes et de colonnes de la vue
+- base : numéro du premier élément des index (1 pour les sommets d'une classe, utilisés tels quels)
+**/
+typedef struct {
+    t_matrix *parent;
+    const int *lignes;
+    const int *cols;
+    int nb_lignes;
+    int nb_cols;
+    int base;
+} t_vue_matrice;
+
 //*******************PROTOTYPE**********************/
 
 t_matrix* creer_matrice_liste_adjacence(listeAdj* g);
 t_matrix* creer_matrice_valzeros(int lignes, int cols);
 t_matrix* multiplication_matrice(t_matrix* a, t_matrix* b);
 t_matrix* difference_matrice(t_matrix* a, t_matrix* b);
-void copie_matrice(t_matrix* src, t_matrix* dest);
+int copie_matrice(t_matrix* src, t_matrix* dest);
 t_matrix* multiplication_matrice(t_matrix* M, t_matrix* N);
 double difference_matrix(t_matrix* M, t_matrix* N);
-void afficher_matrice(t_matrix* matrice);
+t_matrix* converger_puissances(t_matrix* M, double epsilon, int max_iter, int *iterations, double *difference);
 void liberer_matrice(t_matrix* matrice);
 t_matrix* subMatrix(t_matrix* matrix, t_partition* part, int compo_index);
 t_matrix* extractSquareSubMatrix(t_matrix* matrix, t_partition* part, int compo_index);
 int getPeriod(t_matrix* sub_matrix);
 int gcd(int *vals, int nbvals);
+int vue_sous_matrice(t_matrix* matrix, t_partition* part, int compo_index, t_vue_matrice *vue);
+int vue_sous_matrice_carree(t_matrix* matrix, t_partition* part, int compo_index, t_vue_matrice *vue);
+t_matrix* vue_copier(const t_vue_matrice *vue);
+t_matrix* multiplication_vue(const t_vue_matrice *vue, t_matrix* M);
+int vue_periode(const t_vue_matrice *vue);
+
+// Ligne i de la vue dans la parente, et numéro dans la parente de la colonne j
+static inline const double* vue_ligne(const t_vue_matrice *vue, int i) {
+    return vue->parent->data[(vue->lignes != NULL) ? vue->lignes[i] - vue->base : i];
+}
+
+static inline int vue_col(const t_vue_matrice *vue, int j) {
+    return (vue->cols != NULL) ? vue->cols[j] - vue->base : j;
+}
+
 /**
  * @brief Extract a submatrix corresponding to a specific component of a graph partition.
  *
@@ -0,0 +1,45 @@
+#ifndef __MISE_A_JOUR_H__
+#define __MISE_A_JOUR_H__
+#include "list.h"
+
+/* Mise à jour incrémentale d'une loi stationnaire après la modification de
+ * quelques probabilités de transition, sans recalcul complet. L'ancienne loi x
+ * vérifie x = xP ; avec P' = P + D, le résidu r = xP' - x = xD n'est non nul
+ * qu'aux arrivées des arêtes modifiées. Chaque poussée sur un état u résout
+ * (presque entièrement) son équation, x[u] += r[u] / (1 - P'[u][u]), et
+ * reporte son résidu sur ses successeurs : seuls les états dont le résidu
+ * dépasse le seuil sont visités, les autres ne sont jamais lus. Le gain
+ * dépend de la portée de la correction : immédiat sur une chaîne qui mélange
+ * vite, limité par le budget de poussées sur une chaîne lente (longue bande).
+ */
+
+/** Modification d'une probabilité de transition:
+- Sommets de départ et d'arrivée (numéros du fichier)
+- Nouvelle probabilité (0 : l'arête est retirée, une arête absente est ajoutée)
+**/
+typedef struct {
+    int depart;
+    int arrivee;
+    double proba;
+} t_modification;
+
+/** Bilan d'une mise à jour:
+- Nombre de poussées et d'arêtes parcourues par les poussées
+- Nombre d'états dont le résidu a été non nul (les seuls états lus ou modifiés avant la normalisation)
+- Résidu restant ||x'P' - x'||_1 (au plus seuil par état touché si le budget n'est pas épuisé)
+**/
+typedef struct {
+    long long nb_poussees;
+    long long nb_aretes;
+    int nb_touches;
+    double residu;
+} t_bilan_maj;
+
+
+//*******PROTOTYPES*******/
+
+int appliquer_modifications(listeAdj *g, const t_modification *mods, int nb, double *delta);
+int mettre_a_jour_stationnaire(listeAdj *g, double *pi, const t_modification *mods, int nb,
+                               double seuil, long long max_poussees, t_bilan_maj *bilan);
+
+#endif
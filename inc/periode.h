@@ -0,0 +1,16 @@
+#ifndef __PERIODE_H__
+#define __PERIODE_H__
+#include "list.h"
+#include "tarjan.h"
+
+/* Périodes des classes calculées sur le graphe (parcours en largeur, O(N + E)),
+ * sans matrice dense : la période d'une classe est le pgcd des
+ * niveau(u) + 1 - niveau(v) sur ses arêtes internes u -> v, et la position
+ * cyclique d'un sommet est son niveau modulo la période.
+ */
+
+//*******PROTOTYPES*******/
+
+int calculer_periodes(listeAdj *g, t_partition *partition, int *periodes, int *position);
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef __PROPAGATION_H__
+#define __PROPAGATION_H__
+#include "list.h"
+#include "creuse.h"
+#include "compression.h"
+#include "matrix.h"
+
+/* Propagation groupée de K distributions initiales : un seul parcours des
+ * arêtes par pas sert les K scénarios. Le bloc interne est rangé sommet par
+ * sommet (N x K, les K scénarios d'un sommet sont contigus) pour que la
+ * boucle sur les scénarios soit vectorisée par le compilateur.
+ */
+
+/** Points de reprise d'une propagation longue:
+- Fichier du point de reprise (relu au départ s'il vient du même calcul)
+- Intervalle minimal entre deux points (secondes)
+- En retour : pas repris du fichier (0 si départ des distributions initiales),
+  nombre de points écrits et code de la dernière écriture
+**/
+typedef struct {
+    const char *fichier;
+    double intervalle;
+    long long reprise;
+    int points;
+    int code;
+} t_reprise;
+
+//*******PROTOTYPES*******/
+
+t_matrix* propager_distributions(listeAdj *g, t_matrix *init, int n);
+void propager_bloc(const t_csr *csr, double *bloc, int K, int n);
+t_matrix* propager_distributions_reprise(listeAdj *g, t_matrix *init, int n, t_reprise *reprise);
+t_matrix* propager_distributions_compresse(const t_graphe_compresse *gc, t_matrix *init, int n);
+
+#endif
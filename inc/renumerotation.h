@@ -0,0 +1,49 @@
+#ifndef __RENUMEROTATION_H__
+#define __RENUMEROTATION_H__
+#include "list.h"
+#include "tarjan.h"
+#include "matrix.h"
+
+/** Ordres de renumérotation des états (localité mémoire des parcours):
+- ORIGINE : numéros du fichier
+- CLASSES : classes dans l'ordre topologique (les sources d'abord), chaque classe d'un seul tenant
+- LARGEUR : parcours en largeur depuis les sommets non visités, dans l'ordre des listes
+- RCM : Cuthill-McKee inverse sur le graphe symétrisé (réduit la largeur de bande)
+**/
+typedef enum {
+    ORDRE_ORIGINE,
+    ORDRE_CLASSES,
+    ORDRE_LARGEUR,
+    ORDRE_RCM,
+    ORDRE_NB
+} t_ordre;
+
+// Sens d'application d'une permutation
+#define PERMUTER  0
+#define RESTAURER 1
+
+/** Permutation des états (indices C, 0-based):
+- Nombre de sommets
+- nouveau[i] : numéro dans le graphe renuméroté de l'état i du fichier
+- ancien[k] : état du fichier placé au numéro k
+**/
+typedef struct {
+    int nb_sommets;
+    int *nouveau;
+    int *ancien;
+} t_permutation;
+
+
+//*******PROTOTYPES*******/
+
+const char* nom_ordre(t_ordre ordre);
+int ordre_depuis_nom(const char *nom);
+t_permutation* calculer_permutation(listeAdj *g, t_partition *partition, t_ordre ordre);
+void liberer_permutation(t_permutation *perm);
+listeAdj permuter_graphe(listeAdj *g, const t_permutation *perm);
+t_matrix* permuter_colonnes(t_matrix *m, const t_permutation *perm, int sens);
+t_matrix* permuter_matrice(t_matrix *m, const t_permutation *perm, int sens);
+void restaurer_partition(t_partition *partition, const t_permutation *perm);
+double ecart_moyen(listeAdj *g, const t_permutation *perm);
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef __REPRISE_H__
+#define __REPRISE_H__
+#include <stddef.h>
+#include <pthread.h>
+
+/* Points de reprise des calculs itératifs longs. L'état courant est copié
+ * dans un tampon d'attente (seul moment où le calcul est bloqué) et un thread
+ * l'écrit pendant que le calcul continue. Le fichier est d'abord écrit sous
+ * un nom temporaire puis renommé : une interruption pendant l'écriture laisse
+ * le point précédent intact.
+ *
+ * Fichier (binaire, ordre des octets de la machine) :
+ *   "MKVREPRI", version, signature du calcul, itération, écart du dernier pas,
+ *   nombre de valeurs, puis les valeurs.
+ */
+
+/** Point de reprise:
+- Signature du calcul (chaîne et état de départ) : le point d'un autre calcul est ignoré
+- Itération atteinte et écart (norme max) entre les deux derniers itérés
+- État courant : nb_valeurs réels
+**/
+typedef struct {
+    unsigned long long signature;
+    long long iteration;
+    double residu;
+    size_t nb_valeurs;
+    double *valeurs;
+} t_point_reprise;
+
+/** Écriture des points en arrière-plan:
+- Fichier de destination et son nom temporaire
+- Thread d'écriture, verrou et signal de réveil
+- Dernier point soumis pas encore écrit (un point plus récent remplace le précédent)
+- Tampon du point en cours d'écriture, propre au thread
+- Demande d'arrêt, nombre de points écrits et code de la dernière écriture
+**/
+typedef struct {
+    char *chemin;
+    char *chemin_temporaire;
+    pthread_t thread;
+    pthread_mutex_t verrou;
+    pthread_cond_t signal;
+    t_point_reprise attente;
+    int en_attente;
+    t_point_reprise ecriture;
+    int arret;
+    int ecrits;
+    int code;
+} t_ecrivain_reprise;
+
+
+//*******PROTOTYPES*******/
+
+int reprise_ecrire(const char *chemin, const char *chemin_temporaire, const t_point_reprise *point);
+int reprise_charger(const char *chemin, unsigned long long signature, size_t nb_valeurs, t_point_reprise *point);
+t_ecrivain_reprise* demarrer_ecrivain_reprise(const char *chemin, size_t nb_valeurs);
+void ecrivain_soumettre(t_ecrivain_reprise *ecrivain, unsigned long long signature, long long iteration,
+                        double residu, const double *valeurs);
+int arreter_ecrivain_reprise(t_ecrivain_reprise *ecrivain, int *ecrits);
+
+#endif
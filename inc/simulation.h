@@ -0,0 +1,51 @@
+#ifndef __SIMULATION_H__
+#define __SIMULATION_H__
+#include "list.h"
+#include "tarjan.h"
+
+/** Paramètres d'une simulation de Monte-Carlo:
+- Nombre de marches indépendantes et nombre de pas de chaque marche
+- Nombre de threads et graine (le résultat ne dépend que de la graine)
+- Distribution initiale (N valeurs), ou à défaut un état de départ (1 à N)
+- Si arreter_absorption vaut 1, une marche s'arrête dès qu'elle entre dans une classe persistante
+**/
+typedef struct {
+    long long nb_marches;
+    int nb_pas;
+    int nb_threads;
+    unsigned long long graine;
+    const double *distribution_init;
+    int etat_init;
+    int arreter_absorption;
+} t_params_simulation;
+
+/** Résultat agrégé d'une simulation (compteurs entiers, donc indépendants de l'ordre des threads):
+- visites[i] : nombre de passages par le sommet i+1 sur toutes les marches (pas 0 compris)
+- fin[i] : nombre de marches terminées sur le sommet i+1
+- departs[i] : nombre de marches parties du sommet i+1
+- absorbees_depart[i], somme_temps[i] : marches parties de i+1 ayant atteint une classe persistante et somme de leurs temps d'atteinte
+- absorptions[k] : nombre de marches absorbées par la k-ième classe persistante (indice dans classes_persistantes)
+**/
+typedef struct {
+    int nb_sommets;
+    long long nb_marches;
+    int nb_pas;
+    unsigned long long *visites;
+    unsigned long long *fin;
+    unsigned long long *departs;
+    unsigned long long *absorbees_depart;
+    unsigned long long *somme_temps;
+    int nb_persistantes;
+    int *classes_persistantes;
+    unsigned long long *absorptions;
+    unsigned long long nb_non_absorbees;
+} t_resultat_simulation;
+
+
+//*******PROTOTYPES*******/
+
+void params_simulation_par_defaut(t_params_simulation *p);
+t_resultat_simulation* simuler_marches(listeAdj *g, t_partition *partition, const t_params_simulation *p);
+void liberer_simulation(t_resultat_simulation *res);
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef __SORTIE_H__
+#define __SORTIE_H__
+#include <stdio.h>
+#include "matrix.h"
+
+// Profondeur maximale d'imbrication (chaîne > section > table > ligne > liste)
+#define SORTIE_PROFONDEUR_MAX 16
+
+// Formats de sortie
+typedef enum {
+    FORMAT_TEXTE,
+    FORMAT_JSON,
+    FORMAT_CSV
+} t_format_sortie;
+
+/** Niveaux de verbosité (chacun inclut les précédents):
+- SILENCIEUX : seulement les erreurs
+- RESUME : valeurs globales de chaque section (verdicts, nombres, résidus)
+- NORMAL : tables par état ou par classe et matrices, tant qu'elles restent petites
+- DETAIL : tout, y compris les grandes matrices et la liste des arêtes
+**/
+typedef enum {
+    NIVEAU_SILENCIEUX,
+    NIVEAU_RESUME,
+    NIVEAU_NORMAL,
+    NIVEAU_DETAIL
+} t_niveau;
+
+/** Destination des résultats d'une analyse. Les algorithmes produisent des données,
+la sortie choisit le format (texte, JSON, CSV) et ce qui est écrit selon le niveau:
+- Fichier de destination, format et niveau de verbosité
+- Chaîne, section et table en cours (colonnes du CSV)
+- Numéro de la ligne en cours dans la table
+- Pile "premier élément" pour placer les virgules du JSON
+**/
+typedef struct {
+    FILE *fichier;
+    t_format_sortie format;
+    t_niveau niveau;
+    char chaine[256];
+    char section[64];
+    char table[64];
+    int ligne;
+    int dans_ligne;
+    int chaine_ouverte;
+    int profondeur;
+    int premier[SORTIE_PROFONDEUR_MAX];
+} t_sortie;
+
+
+//*******PROTOTYPES*******/
+
+t_sortie* creer_sortie(FILE *fichier, t_format_sortie format, t_niveau niveau);
+int sortie_actif(const t_sortie *s, t_niveau niveau);
+void sortie_nommer_chaine(t_sortie *s, const char *nom);
+void sortie_debut_chaine(t_sortie *s, const char *nom, int nb_sommets, long long nb_aretes);
+void sortie_fin_chaine(t_sortie *s);
+void sortie_debut_section(t_sortie *s, const char *cle, const char *titre);
+void sortie_fin_section(t_sortie *s);
+void sortie_debut_table(t_sortie *s, const char *cle);
+void sortie_fin_table(t_sortie *s);
+void sortie_debut_ligne(t_sortie *s);
+void sortie_fin_ligne(t_sortie *s);
+void sortie_entier(t_sortie *s, const char *cle, long long valeur);
+void sortie_reel(t_sortie *s, const char *cle, double valeur);
+void sortie_booleen(t_sortie *s, const char *cle, int valeur);
+void sortie_texte(t_sortie *s, const char *cle, const char *valeur);
+void sortie_liste_entiers(t_sortie *s, const char *cle, const int *valeurs, int nb);
+void sortie_matrice(t_sortie *s, const char *cle, t_matrix *m);
+void sortie_erreur(t_sortie *s, const char *message);
+void sortie_chaine_json(FILE *f, const char *texte);
+void liberer_sortie(t_sortie *s);
+
+#endif
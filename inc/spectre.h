@@ -0,0 +1,44 @@
+#ifndef __SPECTRE_H__
+#define __SPECTRE_H__
+#include "list.h"
+#include "tarjan.h"
+
+/* Trou spectral des classes persistantes. Sur une classe fermée, les vecteurs
+ * de somme nulle restent de somme nulle après x -> xP : restreint à ce
+ * sous-espace, P n'a plus la valeur propre 1 et sa plus grande valeur propre
+ * en module est le SLEM (second largest eigenvalue modulus). On l'estime par
+ * Arnoldi (produits matrice creuse - vecteur uniquement), puis QR sur la
+ * petite matrice de Hessenberg obtenue.
+ * Une classe périodique de période d a un SLEM de 1 (racines d-ièmes de
+ * l'unité) ; la chaîne paresseuse (P + I) / 2, itérée par calculer_limite,
+ * a pour valeurs propres (lambda + 1) / 2 et converge toujours.
+ */
+
+// Dimension maximale de l'espace de Krylov par classe
+#define DIMENSION_KRYLOV 40
+
+/** Estimation spectrale par classe persistante:
+- Nombre de classes persistantes et leurs indices dans la partition
+- slem[k] : plus grand module de valeur propre autre que 1 de P restreinte à la classe
+- slem_paresseuse[k] : même chose pour (P + I) / 2
+- dimension[k] : dimension de l'espace de Krylov utilisé (taille - 1 au plus)
+- Nombre total de produits matrice - vecteur
+**/
+typedef struct {
+    int nb_classes;
+    int *classes;
+    double *slem;
+    double *slem_paresseuse;
+    int *dimension;
+    long long produits;
+} t_spectre;
+
+
+//*******PROTOTYPES*******/
+
+t_spectre* estimer_spectre(listeAdj *g, t_partition *partition, int dimension_max);
+int spectre_temps_melange(double slem, double epsilon);
+int spectre_iterations_limite(const t_spectre *sp, double epsilon);
+void liberer_spectre(t_spectre *sp);
+
+#endif
@@ -56,10 +56,11 @@ typedef struct tarjan_data {
 //*******PROTOTYPES*******/
 
 t_tarjan_data* initialiser_tarjan(listeAdj *g);
+void ajouter_classe(t_partition *partition, int *sommets, int taille);
 void tarjan_parcours(t_tarjan_data *data, int sommet_index);
 t_partition* algorithme_tarjan(listeAdj g);
 void liberer_tarjan(t_tarjan_data *data);
-void afficher_partition(t_partition *partition);
+void liberer_partition(t_partition *partition);
 t_partition* tarjan_calculer_partition(listeAdj g);
 
 #endif
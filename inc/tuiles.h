@@ -0,0 +1,57 @@
+#ifndef __TUILES_H__
+#define __TUILES_H__
+#include <stddef.h>
+#include "list.h"
+#include "matrix.h"
+
+/* Matrices denses hors mémoire : les coefficients sont dans un fichier
+ * projeté en mémoire (mmap) et rangés par tuiles carrées contiguës de
+ * taille_tuile x taille_tuile. Un produit ou une différence parcourt la
+ * matrice tuile par tuile : seules quelques tuiles sont en mémoire à la fois,
+ * la suivante est annoncée au noyau (madvise WILLNEED) pendant le calcul de
+ * la courante, et les tuiles terminées sont rendues (DONTNEED). La taille
+ * d'une matrice n'est plus limitée que par le disque.
+ *
+ * Fichier : un en-tête de 4096 octets ("MKVTUILE", version, lignes,
+ * colonnes, taille des tuiles) puis les tuiles ligne de tuiles par ligne de
+ * tuiles, chacune rangée ligne par ligne et complétée par des zéros au bord.
+ */
+
+#define TAILLE_TUILE_DEFAUT 256
+// Les tuiles sont alignées sur les pages : taille_tuile multiple de 32 (32 * 32 * 8 = 8192 octets)
+#define MULTIPLE_TUILE 32
+
+/** Matrice dense sur fichier projeté:
+- Nombre de lignes et de colonnes, taille des tuiles et nombre de tuiles par ligne / colonne
+- Fichier, son descripteur, projection complète et début des tuiles (après l'en-tête)
+- Taille de la projection en octets
+**/
+typedef struct {
+    int lignes;
+    int cols;
+    int taille_tuile;
+    int tuiles_lignes;
+    int tuiles_cols;
+    char *chemin;
+    int fd;
+    unsigned char *projection;
+    double *donnees;
+    size_t taille;
+} t_matrice_tuiles;
+
+
+//*******PROTOTYPES*******/
+
+t_matrice_tuiles* creer_matrice_tuiles(const char *chemin, int lignes, int cols, int taille_tuile);
+t_matrice_tuiles* ouvrir_matrice_tuiles(const char *chemin);
+double* tuile(const t_matrice_tuiles *m, int bi, int bj);
+double tuiles_lire(const t_matrice_tuiles *m, int i, int j);
+void tuiles_ecrire(t_matrice_tuiles *m, int i, int j, double valeur);
+t_matrice_tuiles* tuiles_depuis_liste(listeAdj *g, const char *chemin, int taille_tuile);
+t_matrice_tuiles* tuiles_depuis_matrice(t_matrix *matrice, const char *chemin, int taille_tuile);
+t_matrix* tuiles_vers_matrice(const t_matrice_tuiles *m);
+t_matrice_tuiles* multiplication_tuiles(const t_matrice_tuiles *A, const t_matrice_tuiles *B, const char *chemin);
+double difference_tuiles(const t_matrice_tuiles *A, const t_matrice_tuiles *B);
+void liberer_matrice_tuiles(t_matrice_tuiles *m, int supprimer_fichier);
+
+#endif
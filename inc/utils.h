@@ -1,8 +1,39 @@
 #ifndef __UTILS_H__
 #define __UTILS_H__
 
+#include <stdio.h>
+
+// Taille d'un identifiant Mermaid (base 26 d'un int : 7 lettres + '\0' suffisent)
+#define TAILLE_ID 16
+
+// Taille par défaut du tampon d'écriture (1 Mo)
+#define TAILLE_TAMPON_SORTIE (1 << 20)
+
+/** Tampon d'écriture en espace utilisateur:
+- Fichier de destination
+- Zone mémoire allouée une seule fois
+- Capacité et nombre d'octets en attente
+- Passe à 1 si une écriture a échoué
+**/
+typedef struct {
+    FILE *fichier;
+    char *buf;
+    size_t capacite;
+    size_t pos;
+    int erreur;
+} t_tampon;
+
 //***************PROTOTYPE*****************/
 
 char* getID(int i);
+int formaterID(int num, char *buf);
+
+t_tampon* ouvrir_tampon(const char *nomFichier, size_t capacite);
+void tampon_ecrire(t_tampon *t, const char *donnees, size_t taille);
+void tampon_chaine(t_tampon *t, const char *chaine);
+void tampon_entier(t_tampon *t, int valeur);
+void tampon_id(t_tampon *t, int num);
+void tampon_proba(t_tampon *t, double proba);
+int fermer_tampon(t_tampon *t);
 
 #endif
@@ -0,0 +1,132 @@
+#include "absorption.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "hasse.h"
+
+/* Les classes sont produites par Tarjan dans l'ordre topologique inverse:
+ * quand on traite une classe transitoire, toutes les classes qu'elle peut
+ * atteindre sont déjà résolues. On résout donc (I - Q) x = b bloc par bloc
+ * avec Gauss-Seidel directement sur les listes d'adjacence, sans jamais
+ * former la matrice fondamentale N = (I - Q)^-1.
+ */
+
+// Un balayage de Gauss-Seidel sur les sommets d'une classe transitoire, renvoie le plus grand écart
+static double balayer_classe(listeAdj *g, t_classe *classe, t_absorption *abs, double *acc) {
+    int K = abs->nb_persistantes;
+    double ecart_max = 0.0;
+
+    for (int s = 0; s < classe->taille; s++) {
+        int i = classe->sommets[s] - 1;
+        double diag = 0.0;
+        double acc_temps = 1.0;
+        for (int k = 0; k < K; k++) acc[k] = 0.0;
+
+        // x_i = somme des P_ij * x_j pour j != i (la boucle P_ii est traitée à part)
+        cell *voisin = g->tab_liste[i].head;
+        while (voisin != NULL) {
+            int j = voisin->sommet_arrivee - 1;
+            double p = voisin->proba;
+            if (j == i) {
+                diag += p;
+            } else {
+                const double *xj = &abs->proba[(size_t)j * K];
+                for (int k = 0; k < K; k++) acc[k] += p * xj[k];
+                acc_temps += p * abs->temps[j];
+            }
+            voisin = voisin->suivante;
+        }
+
+        // Un sommet transitoire ne peut pas boucler sur lui-même avec probabilité 1
+        double denom = 1.0 - diag;
+        if (denom <= 0.0) denom = 1.0;
+
+        double *xi = &abs->proba[(size_t)i * K];
+        for (int k = 0; k < K; k++) {
+            double nouv = acc[k] / denom;
+            double ecart = fabs(nouv - xi[k]);
+            if (ecart > ecart_max) ecart_max = ecart;
+            xi[k] = nouv;
+        }
+
+        // Écart relatif pour le temps moyen qui peut être grand
+        double nouv_temps = acc_temps / denom;
+        double ecart_temps = fabs(nouv_temps - abs->temps[i]) / (nouv_temps > 1.0 ? nouv_temps : 1.0);
+        if (ecart_temps > ecart_max) ecart_max = ecart_temps;
+        abs->temps[i] = nouv_temps;
+    }
+
+    return ecart_max;
+}
+
+//Fonction qui calcule les probabilités d'absorption et les temps moyens d'absorption
+t_absorption* calculer_absorption(listeAdj *g, t_partition *partition, double epsilon, int max_iter) {
+    int n = g->nb_sommets;
+    int *estPersistante = calculer_persistance(partition, g);
+
+    t_absorption *abs = malloc(sizeof(t_absorption));
+    abs->nb_sommets = n;
+    abs->nb_persistantes = 0;
+    abs->iterations = 0;
+    abs->residu = 0.0;
+
+    // Numérotation des classes persistantes
+    abs->rang_persistante = malloc(partition->taille * sizeof(int));
+    abs->classes_persistantes = malloc(partition->taille * sizeof(int));
+    for (int c = 0; c < partition->taille; c++) {
+        if (estPersistante[c]) {
+            abs->rang_persistante[c] = abs->nb_persistantes;
+            abs->classes_persistantes[abs->nb_persistantes++] = c;
+        } else {
+            abs->rang_persistante[c] = -1;
+        }
+    }
+
+    int K = abs->nb_persistantes;
+    abs->proba = calloc((size_t)n * (K > 0 ? K : 1), sizeof(double));
+    abs->temps = calloc(n, sizeof(double));
+
+    // Un sommet persistant est absorbé par sa propre classe en 0 pas
+    for (int c = 0; c < partition->taille; c++) {
+        int k = abs->rang_persistante[c];
+        if (k < 0) continue;
+        for (int s = 0; s < partition->classes[c].taille; s++) {
+            int i = partition->classes[c].sommets[s] - 1;
+            abs->proba[(size_t)i * K + k] = 1.0;
+        }
+    }
+
+    // Résolution classe transitoire par classe transitoire
+    double *acc = malloc((K > 0 ? K : 1) * sizeof(double));
+    for (int c = 0; c < partition->taille; c++) {
+        if (estPersistante[c]) continue;
+
+        t_classe *classe = &partition->classes[c];
+        double ecart;
+        int iter = 0;
+        do {
+            ecart = balayer_classe(g, classe, abs, acc);
+            iter++;
+            // Une classe d'un seul sommet est résolue exactement en un balayage
+            if (classe->taille == 1) ecart = 0.0;
+        } while (ecart > epsilon && iter < max_iter);
+
+        abs->iterations += iter;
+        if (ecart > abs->residu) abs->residu = ecart;
+    }
+
+    free(acc);
+    free(estPersistante);
+    return abs;
+}
+
+
+// Libère la mémoire du résultat d'absorption
+void liberer_absorption(t_absorption *abs) {
+    if (abs == NULL) return;
+    free(abs->classes_persistantes);
+    free(abs->rang_persistante);
+    free(abs->proba);
+    free(abs->temps);
+    free(abs);
+}
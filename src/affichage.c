@@ -0,0 +1,172 @@
+#include "affichage.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Affichage console du mode interactif. La bibliothèque ne fait que calculer :
+ * tout ce qui est écrit sur la sortie standard passe par ce fichier.
+ */
+
+// Affiche toute les arrêtes d'une liste
+void displayListe(liste l) {
+    cell* current = l.head;
+    if (current == NULL) {
+        printf("Empty list\n");
+        return;
+    }
+    while (current != NULL) {
+        printf("-> %d (%.2f) ", current->sommet_arrivee, current->proba);
+        current = current->suivante;
+    }
+    printf("\n");
+}
+
+// Affiche une liste d'adjacence (toutes les listes)
+void displayListeAdj(listeAdj g) {
+    for (int i = 0; i < g.nb_sommets; i++) {
+        printf("Sommet %d: ", i + 1);
+        displayListe(g.tab_liste[i]);
+    }
+}
+
+// Affiche la vérification du graphe de Markov faite à la lecture : sommets fautifs puis verdict
+int afficherVerificationMarkov(const t_validation *v) {
+    for (int k = 0; k < v->nb_signales; k++) {
+        printf("la somme des probabilites du sommet %d est %.6f\n", v->signales[k], v->sommes[k]);
+    }
+    if (v->nb_invalides > v->nb_signales) {
+        printf("... et %d autre(s) sommet(s) hors tolerance\n", v->nb_invalides - v->nb_signales);
+    }
+    if (v->nb_renormalisees > 0) {
+        printf("%d ligne(s) renormalisee(s)\n", v->nb_renormalisees);
+    }
+
+    if (v->markov) {
+        printf("Le graphe est un graphe de Markov\n");
+    } else {
+        printf("Le graphe n'est pas un graphe de Markov\n");
+    }
+    return v->markov;
+}
+
+//Fonction pour afficher la matrice
+void afficher_matrice(t_matrix* matrice) {
+    for (int i = 0; i < matrice->lignes; i++) {
+        for (int j = 0; j < matrice->cols; j++) {
+            printf("%.2f\t", matrice->data[i][j]);
+        }
+        printf("\n");
+    }
+}
+
+// Affiche une vue comme afficher_matrice, en lisant la matrice parente
+void afficher_vue(const t_vue_matrice *vue) {
+    for (int i = 0; i < vue->nb_lignes; i++) {
+        const double *ligne = vue_ligne(vue, i);
+        for (int j = 0; j < vue->nb_cols; j++) {
+            printf("%.2f\t", ligne[vue_col(vue, j)]);
+        }
+        printf("\n");
+    }
+}
+
+// Fonction pour afficher une partition
+void afficher_partition(t_partition *partition) {
+    printf("Partition du graphe :\n");
+
+    for (int i = 0; i < partition->taille; i++) {
+        printf("%s: {", partition->classes[i].nom);
+
+        for (int j = 0; j < partition->classes[i].taille; j++) {
+            printf("%d", partition->classes[i].sommets[j]);
+            if (j < partition->classes[i].taille - 1) printf(",");
+        }
+        printf("}\n");
+    }
+}
+
+// Affiche les composantes trouvées par Tarjan, dans leur ordre de découverte
+void afficher_composantes(t_partition *partition) {
+    printf("Algorithme de Tarjan\n");
+    for (int i = 0; i < partition->taille; i++) {
+        printf("Composante %s: {", partition->classes[i].nom);
+        for (int j = partition->classes[i].taille - 1; j >= 0; j--) {
+            printf("%d", partition->classes[i].sommets[j]);
+            if (j > 0) printf(",");
+        }
+        printf("}\n");
+    }
+}
+
+//Fonction pour analyser les caractéristiques de notre graphe
+void analyserCarac(t_partition *partition, listeAdj *g) {
+    printf("\nCaracteristique du graphe\n");
+
+    // Vérifier si chaque classe est persistante
+    int *estPersistante = calculer_persistance(partition, g);
+
+    // Affichage
+    printf("\n");
+    for (int i = 0; i < partition->taille; i++) {
+        printf("La classe {");
+        for (int j = 0; j < partition->classes[i].taille; j++) {
+            printf("%d%s", partition->classes[i].sommets[j],
+                   (j < partition->classes[i].taille - 1) ? "," : "");
+        }
+        printf("} est %s", estPersistante[i] ? "persistante" : "transitoire");
+
+        // Affichage des états
+        if (partition->classes[i].taille == 1) {
+            printf(" : l'etat %d est %s", partition->classes[i].sommets[0],
+                   estPersistante[i] ? "persistant" : "transitoire");
+            if (estPersistante[i]) printf(" : l'etat %d est absorbant", partition->classes[i].sommets[0]);
+        } else {
+            printf(" : les etats ");
+            for (int j = 0; j < partition->classes[i].taille; j++) {
+                printf("%d", partition->classes[i].sommets[j]);
+                if (j < partition->classes[i].taille - 2) printf(", ");
+                else if (j == partition->classes[i].taille - 2) printf(" et ");
+            }
+            printf(" sont %s", estPersistante[i] ? "persistants" : "transitoires");
+        }
+        printf(";\n");
+    }
+
+    // Irréductibilité
+    printf("Le graphe de Markov ");
+    if (partition->taille == 1) {
+        printf("est irreductible.\n");
+    } else {
+        printf("n'est pas irreductible.\n");
+    }
+
+    free(estPersistante);
+}
+
+//Fonction pour afficher les probabilités et temps d'absorption des sommets transitoires
+void afficher_absorption(t_absorption *abs, t_partition *partition) {
+    int K = abs->nb_persistantes;
+    int *corresp = creer_tab_corresp(partition, abs->nb_sommets);
+
+    printf("Absorption par les classes persistantes (%d balayages, residu = %.2e)\n",
+           abs->iterations, abs->residu);
+
+    int nb_transitoires = 0;
+    for (int i = 0; i < abs->nb_sommets; i++) {
+        if (abs->rang_persistante[corresp[i]] >= 0) continue;
+        nb_transitoires++;
+
+        printf("Etat %d :", i + 1);
+        for (int k = 0; k < K; k++) {
+            printf(" P(-> %s) = %.4f", partition->classes[abs->classes_persistantes[k]].nom,
+                   abs->proba[(size_t)i * K + k]);
+            if (k < K - 1) printf(",");
+        }
+        printf(" ; temps moyen d'absorption = %.4f\n", abs->temps[i]);
+    }
+
+    if (nb_transitoires == 0) {
+        printf("Aucun etat transitoire.\n");
+    }
+
+    free(corresp);
+}
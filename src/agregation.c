@@ -0,0 +1,352 @@
+#include "agregation.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "alea.h"
+#include "hasse.h"
+#include "periode.h"
+
+/* Regroupement des états de même ligne. La signature d'un état est son bloc
+ * de départ suivi de la liste (état d'arrivée, probabilité) : deux états de
+ * même signature ont la même ligne dans M, et M = A R où A indique le bloc de
+ * chaque état et R donne la ligne commune de chaque bloc. La chaîne quotient
+ * Q = R A vérifie M^(k+1) = A Q^k R : les limites de Q se relèvent exactement
+ * sur les états d'origine (agregation_relever), et Q a les mêmes valeurs
+ * propres non nulles que M.
+ * Regrouper des états de lignes seulement proportionnelles par bloc
+ * (lumpabilité forte) réduirait davantage, mais la loi de chaque état à
+ * l'intérieur d'un bloc serait perdue.
+ * Les probabilités sont comparées après arrondi au pas de la tolérance (pas
+ * minimal PAS_EXACT : les probabilités sont stockées en float).
+ * Limite de cet arrondi : deux probabilités à moins d'un pas l'une de l'autre
+ * peuvent tomber de part et d'autre d'une frontière de la grille (avec un pas
+ * de 0.01, 0.1049 et 0.1051 donnent 10 et 11) et séparer deux états que la
+ * tolérance autoriserait à regrouper. Le résultat reste correct mais peut
+ * être moins agrégé que possible : deux états d'un même bloc diffèrent de
+ * moins d'un pas par état d'arrivée, deux états qui diffèrent d'un pas ou
+ * plus sont toujours séparés, entre les deux cela dépend des valeurs.
+ * La partition de départ sépare les classes de Tarjan et, dans une classe
+ * périodique, les positions cycliques : la chaîne agrégée a donc les mêmes
+ * classes et les mêmes périodes que la chaîne d'origine.
+ */
+
+#define PAS_EXACT 1e-6
+
+// Terme d'une signature : état d'arrivée et probabilité
+typedef struct {
+    int cible;
+    double proba;
+} t_terme;
+
+// Empreinte de la signature d'un état, pour regrouper les signatures égales par un tri
+typedef struct {
+    unsigned long long empreinte;
+    int etat;
+} t_empreinte;
+
+static int comparer_termes(const void *a, const void *b) {
+    return ((const t_terme*)a)->cible - ((const t_terme*)b)->cible;
+}
+
+static int comparer_entiers(const void *a, const void *b) {
+    return *(const int*)a - *(const int*)b;
+}
+
+static int comparer_empreintes(const void *a, const void *b) {
+    const t_empreinte *x = a, *y = b;
+    if (x->empreinte != y->empreinte) return (x->empreinte > y->empreinte) ? 1 : -1;
+    return x->etat - y->etat;
+}
+
+/** Signatures de tous les états (même découpage que le CSR):
+- debut[i]..debut[i+1]-1 : termes de l'état i
+- cible, quantum : état d'arrivée (indice C) et probabilité arrondie au pas
+**/
+typedef struct {
+    int *debut;
+    int *cible;
+    long long *quantum;
+} t_signatures;
+
+// Calcule la signature de chaque état (termes triés par arrivée, probabilités d'une même arrivée cumulées)
+static void calculer_signatures(listeAdj *g, double pas, t_signatures *sig, t_terme *tampon) {
+    int e = 0;
+    for (int i = 0; i < g->nb_sommets; i++) {
+        sig->debut[i] = e;
+        int nb = 0;
+        for (cell *c = g->tab_liste[i].head; c != NULL; c = c->suivante) {
+            tampon[nb].cible = c->sommet_arrivee - 1;
+            tampon[nb].proba = c->proba;
+            nb++;
+        }
+        qsort(tampon, nb, sizeof(t_terme), comparer_termes);
+
+        for (int k = 0; k < nb; k++) {
+            double somme = tampon[k].proba;
+            while (k + 1 < nb && tampon[k + 1].cible == tampon[k].cible) somme += tampon[++k].proba;
+            sig->cible[e] = tampon[k].cible;
+            sig->quantum[e] = llround(somme / pas);
+            e++;
+        }
+    }
+    sig->debut[g->nb_sommets] = e;
+}
+
+static int signatures_egales(const t_signatures *sig, const int *bloc, int a, int b) {
+    if (bloc[a] != bloc[b]) return 0;
+    int la = sig->debut[a + 1] - sig->debut[a];
+    if (la != sig->debut[b + 1] - sig->debut[b]) return 0;
+    for (int k = 0; k < la; k++) {
+        if (sig->cible[sig->debut[a] + k] != sig->cible[sig->debut[b] + k]) return 0;
+        if (sig->quantum[sig->debut[a] + k] != sig->quantum[sig->debut[b] + k]) return 0;
+    }
+    return 1;
+}
+
+// Découpe les blocs de départ selon les signatures : renvoie le nombre de blocs (nouveau_bloc rempli)
+static int regrouper(int n, const int *bloc, const t_signatures *sig, t_empreinte *cles, int *meneurs, int *nouveau_bloc) {
+    for (int i = 0; i < n; i++) {
+        unsigned long long h = alea_melanger((unsigned long long)bloc[i]);
+        for (int e = sig->debut[i]; e < sig->debut[i + 1]; e++) {
+            h = alea_melanger(h ^ (unsigned long long)sig->cible[e]);
+            h = alea_melanger(h ^ (unsigned long long)sig->quantum[e]);
+        }
+        cles[i].empreinte = h;
+        cles[i].etat = i;
+    }
+    qsort(cles, n, sizeof(t_empreinte), comparer_empreintes);
+
+    // Dans une série d'empreintes égales, on compare les signatures aux meneurs déjà vus (collisions)
+    int nb_blocs = 0;
+    for (int debut = 0; debut < n; ) {
+        int fin = debut;
+        while (fin < n && cles[fin].empreinte == cles[debut].empreinte) fin++;
+        int nb_meneurs = 0;
+        for (int k = debut; k < fin; k++) {
+            int s = cles[k].etat;
+            int m = 0;
+            while (m < nb_meneurs && !signatures_egales(sig, bloc, meneurs[m], s)) m++;
+            if (m == nb_meneurs) {
+                meneurs[nb_meneurs++] = s;
+                nouveau_bloc[s] = nb_blocs++;
+            } else {
+                nouveau_bloc[s] = nouveau_bloc[meneurs[m]];
+            }
+        }
+        debut = fin;
+    }
+    return nb_blocs;
+}
+
+// Partition de départ : classe de Tarjan et position cyclique (un seul bloc sans partition)
+static int partition_initiale(listeAdj *g, t_partition *partition, int *bloc) {
+    int n = g->nb_sommets;
+    if (partition == NULL) {
+        for (int i = 0; i < n; i++) bloc[i] = 0;
+        return (n > 0) ? 1 : 0;
+    }
+
+    int *periodes = malloc(partition->taille * sizeof(int));
+    int *position = malloc(n * sizeof(int));
+    int *decalage = malloc(partition->taille * sizeof(int));
+    int *corresp = creer_tab_corresp(partition, n);
+    calculer_periodes(g, partition, periodes, position);
+
+    int nb = 0;
+    for (int c = 0; c < partition->taille; c++) {
+        decalage[c] = nb;
+        nb += (periodes[c] > 0) ? periodes[c] : 1;
+    }
+    for (int i = 0; i < n; i++) bloc[i] = decalage[corresp[i]] + position[i];
+
+    free(periodes);
+    free(position);
+    free(decalage);
+    free(corresp);
+    return nb;
+}
+
+// Ajoute une ligne creuse (indices C dans touches, valeurs dans ligne) en ordre croissant et remet ligne à 0
+static void ajouter_ligne(liste *l, double *ligne, int *touches, int nb_touches) {
+    // addCell ajoute en tête : arrivées parcourues en ordre décroissant
+    qsort(touches, nb_touches, sizeof(int), comparer_entiers);
+    for (int t = nb_touches - 1; t >= 0; t--) {
+        addCell(l, touches[t] + 1, (float)ligne[touches[t]]);
+        ligne[touches[t]] = 0.0;
+    }
+}
+
+// Construit les lignes communes R (moyenne des lignes d'un bloc), la chaîne quotient R A et
+// mesure l'écart des états à la ligne de leur bloc
+static void construire_quotient(listeAdj *g, t_agregation *agr) {
+    int n = agr->nb_sommets, B = agr->nb_blocs;
+    size_t taille_tab = (n > 0) ? (size_t)n : 1;
+    agr->lignes = createListeAdj(B);
+    agr->quotient = createListeAdj(B);
+    double *ligne = calloc(taille_tab, sizeof(double));
+    double *ligne_etat = calloc(taille_tab, sizeof(double));
+    char *vu = calloc(taille_tab, sizeof(char));
+    int *touches = malloc(taille_tab * sizeof(int));
+    agr->ecart = 0.0;
+
+    for (int b = 0; b < B; b++) {
+        int taille = agr->debut[b + 1] - agr->debut[b];
+        int nb_touches = 0;
+        for (int k = agr->debut[b]; k < agr->debut[b + 1]; k++) {
+            int i = agr->membres[k] - 1;
+            for (cell *c = g->tab_liste[i].head; c != NULL; c = c->suivante) {
+                int cible = c->sommet_arrivee - 1;
+                if (!vu[cible]) {
+                    vu[cible] = 1;
+                    touches[nb_touches++] = cible;
+                }
+                ligne[cible] += c->proba;
+            }
+        }
+        for (int t = 0; t < nb_touches; t++) ligne[touches[t]] /= taille;
+
+        // Écart de chaque état à la ligne moyenne (nul si l'agrégation est exacte)
+        for (int k = agr->debut[b]; k < agr->debut[b + 1]; k++) {
+            int i = agr->membres[k] - 1;
+            for (cell *c = g->tab_liste[i].head; c != NULL; c = c->suivante) {
+                ligne_etat[c->sommet_arrivee - 1] += c->proba;
+            }
+            double ecart = 0.0;
+            for (int t = 0; t < nb_touches; t++) {
+                ecart += fabs(ligne_etat[touches[t]] - ligne[touches[t]]);
+                ligne_etat[touches[t]] = 0.0;
+            }
+            if (ecart > agr->ecart) agr->ecart = ecart;
+        }
+
+        for (int t = 0; t < nb_touches; t++) vu[touches[t]] = 0;
+        ajouter_ligne(&agr->lignes.tab_liste[b], ligne, touches, nb_touches);
+    }
+
+    // Ligne du quotient : la ligne commune cumulée par bloc d'arrivée
+    for (int b = 0; b < B; b++) {
+        int nb_touches = 0;
+        for (cell *c = agr->lignes.tab_liste[b].head; c != NULL; c = c->suivante) {
+            int cible = agr->bloc[c->sommet_arrivee - 1];
+            if (!vu[cible]) {
+                vu[cible] = 1;
+                touches[nb_touches++] = cible;
+            }
+            ligne[cible] += c->proba;
+        }
+        for (int t = 0; t < nb_touches; t++) vu[touches[t]] = 0;
+        ajouter_ligne(&agr->quotient.tab_liste[b], ligne, touches, nb_touches);
+    }
+
+    free(ligne);
+    free(ligne_etat);
+    free(vu);
+    free(touches);
+}
+
+//Fonction qui regroupe les états de même ligne (tolérance 0 : lignes identiques)
+t_agregation* agreger_chaine(listeAdj *g, t_partition *partition, double tolerance) {
+    int n = g->nb_sommets;
+    double pas = (tolerance > PAS_EXACT) ? tolerance : PAS_EXACT;
+
+    int nb_aretes = 0, degre_max = 0;
+    for (int i = 0; i < n; i++) {
+        int degre = 0;
+        for (cell *c = g->tab_liste[i].head; c != NULL; c = c->suivante) degre++;
+        nb_aretes += degre;
+        if (degre > degre_max) degre_max = degre;
+    }
+
+    t_agregation *agr = calloc(1, sizeof(t_agregation));
+    int *nouveau_bloc = malloc((n > 0 ? n : 1) * sizeof(int));
+    int *meneurs = malloc((n > 0 ? n : 1) * sizeof(int));
+    t_empreinte *cles = malloc((n > 0 ? n : 1) * sizeof(t_empreinte));
+    t_terme *tampon = malloc((degre_max > 0 ? degre_max : 1) * sizeof(t_terme));
+    t_signatures sig;
+    sig.debut = malloc((n + 1) * sizeof(int));
+    sig.cible = malloc((nb_aretes > 0 ? nb_aretes : 1) * sizeof(int));
+    sig.quantum = malloc((nb_aretes > 0 ? nb_aretes : 1) * sizeof(long long));
+    agr->bloc = malloc((n > 0 ? n : 1) * sizeof(int));
+    if (nouveau_bloc == NULL || meneurs == NULL || cles == NULL || tampon == NULL
+        || sig.debut == NULL || sig.cible == NULL || sig.quantum == NULL || agr->bloc == NULL) {
+        free(nouveau_bloc); free(meneurs); free(cles); free(tampon);
+        free(sig.debut); free(sig.cible); free(sig.quantum);
+        free(agr->bloc); free(agr);
+        return NULL;
+    }
+
+    agr->nb_sommets = n;
+    agr->tolerance = tolerance;
+    partition_initiale(g, partition, agr->bloc);
+
+    // Une seule passe : la signature ne dépend que des états d'arrivée, pas des blocs
+    calculer_signatures(g, pas, &sig, tampon);
+    agr->nb_blocs = regrouper(n, agr->bloc, &sig, cles, meneurs, nouveau_bloc);
+    int *echange = agr->bloc;
+    agr->bloc = nouveau_bloc;
+    nouveau_bloc = echange;
+
+    // Renumérotation par ordre de première apparition : le bloc de l'état 1 est B1
+    int *numero = nouveau_bloc;
+    for (int b = 0; b < agr->nb_blocs; b++) numero[b] = -1;
+    int suivant = 0;
+    for (int i = 0; i < n; i++) {
+        if (numero[agr->bloc[i]] < 0) numero[agr->bloc[i]] = suivant++;
+        agr->bloc[i] = numero[agr->bloc[i]];
+    }
+
+    // Membres de chaque bloc (comptage puis placement, ordre croissant des états)
+    agr->debut = calloc(agr->nb_blocs + 1, sizeof(int));
+    agr->membres = malloc((n > 0 ? n : 1) * sizeof(int));
+    for (int i = 0; i < n; i++) agr->debut[agr->bloc[i] + 1]++;
+    for (int b = 0; b < agr->nb_blocs; b++) agr->debut[b + 1] += agr->debut[b];
+    int *place = meneurs;
+    memcpy(place, agr->debut, agr->nb_blocs * sizeof(int));
+    for (int i = 0; i < n; i++) agr->membres[place[agr->bloc[i]]++] = i + 1;
+
+    construire_quotient(g, agr);
+
+    free(nouveau_bloc);
+    free(meneurs);
+    free(cles);
+    free(tampon);
+    free(sig.debut);
+    free(sig.cible);
+    free(sig.quantum);
+    return agr;
+}
+
+//Fonction qui relève une limite de la chaîne quotient (B x B) sur les états d'origine (N x N) :
+//lim M^(k+1) = A (lim Q^k) R, la ligne d'un état est celle de son bloc
+t_matrix* agregation_relever(t_agregation *agr, t_matrix *limite_quotient) {
+    int n = agr->nb_sommets;
+    if (limite_quotient == NULL || limite_quotient->lignes != agr->nb_blocs || limite_quotient->cols != agr->nb_blocs) return NULL;
+    t_matrix *res = creer_matrice_valzeros(n, n);
+    if (res == NULL) return NULL;
+    for (int b = 0; b < agr->nb_blocs; b++) {
+        if (agr->debut[b + 1] == agr->debut[b]) continue;
+        double *ligne = res->data[agr->membres[agr->debut[b]] - 1];
+        for (int c = 0; c < agr->nb_blocs; c++) {
+            double coef = limite_quotient->data[b][c];
+            if (coef == 0.0) continue;
+            for (cell *e = agr->lignes.tab_liste[c].head; e != NULL; e = e->suivante) {
+                ligne[e->sommet_arrivee - 1] += coef * e->proba;
+            }
+        }
+        for (int k = agr->debut[b] + 1; k < agr->debut[b + 1]; k++) {
+            memcpy(res->data[agr->membres[k] - 1], ligne, n * sizeof(double));
+        }
+    }
+    return res;
+}
+
+// Libère la mémoire d'une agrégation et de sa chaîne quotient
+void liberer_agregation(t_agregation *agr) {
+    if (agr == NULL) return;
+    liberer_listeAdj(&agr->quotient);
+    liberer_listeAdj(&agr->lignes);
+    free(agr->bloc);
+    free(agr->debut);
+    free(agr->membres);
+    free(agr);
+}
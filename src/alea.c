@@ -0,0 +1,23 @@
+#include "alea.h"
+
+// Fonction de mélange de splitmix64 (bijective, bonne diffusion des bits)
+unsigned long long alea_melanger(unsigned long long x) {
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+// Clé d'un flux indépendant (une marche, un thread...) dérivée de la graine
+unsigned long long alea_cle(unsigned long long graine, unsigned long long flux) {
+    return alea_melanger(graine ^ alea_melanger(flux + 0x632be59bd9b4e019ULL));
+}
+
+// Valeur 64 bits pour le compteur donné du flux
+unsigned long long alea_compteur(unsigned long long cle, unsigned long long compteur) {
+    return alea_melanger(cle + (compteur + 1) * 0x9e3779b97f4a7c15ULL);
+}
+
+// Réel uniforme dans [0, 1[ (53 bits)
+double alea_uniforme(unsigned long long cle, unsigned long long compteur) {
+    return (alea_compteur(cle, compteur) >> 11) * (1.0 / 9007199254740992.0);
+}
@@ -0,0 +1,105 @@
+#include "alias.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Méthode d'alias de Walker (construction de Vose) : chaque sommet de degré d
+ * a d cases ; un tirage choisit une case au hasard puis garde son sommet
+ * d'arrivée ou prend son alias. Tirage en O(1), quel que soit le degré.
+ */
+
+// Construit les cases d'un sommet à partir de ses probabilités (petits/grands : tampons de taille deg)
+static void construire_ligne(const t_csr *csr, int s, t_case_alias *cases, double *echelle, int *petits, int *grands) {
+    int debut = csr->debut[s];
+    int deg = csr->debut[s + 1] - debut;
+
+    // Probabilités renormalisées (la somme d'une ligne peut différer légèrement de 1) et multipliées par deg
+    double somme = 0.0;
+    for (int k = 0; k < deg; k++) somme += csr->proba[debut + k];
+    int nb_petits = 0, nb_grands = 0;
+    for (int k = 0; k < deg; k++) {
+        echelle[k] = (somme > 0.0) ? csr->proba[debut + k] * deg / somme : 1.0;
+        cases[k].arrivee = csr->arrivee[debut + k];
+        cases[k].alias = cases[k].arrivee;
+        if (echelle[k] < 1.0) petits[nb_petits++] = k;
+        else grands[nb_grands++] = k;
+    }
+
+    // Chaque petite case est complétée par une grande
+    while (nb_petits > 0 && nb_grands > 0) {
+        int p = petits[--nb_petits];
+        int g = grands[nb_grands - 1];
+        cases[p].seuil = echelle[p];
+        cases[p].alias = cases[g].arrivee;
+        echelle[g] -= 1.0 - echelle[p];
+        if (echelle[g] < 1.0) {
+            nb_grands--;
+            petits[nb_petits++] = g;
+        }
+    }
+
+    // Restes (erreurs d'arrondi) : cases pleines
+    while (nb_grands > 0) cases[grands[--nb_grands]].seuil = 1.0;
+    while (nb_petits > 0) cases[petits[--nb_petits]].seuil = 1.0;
+}
+
+//Fonction qui construit les tables d'alias à partir de la matrice creuse
+t_alias* creer_alias_csr(const t_csr *csr) {
+    int n = csr->nb_sommets;
+    t_alias *tables = malloc(sizeof(t_alias));
+    tables->nb_sommets = n;
+    tables->nb_aretes = csr->nb_aretes;
+    tables->debut = malloc((n + 1) * sizeof(int));
+    tables->cases = malloc((csr->nb_aretes > 0 ? csr->nb_aretes : 1) * sizeof(t_case_alias));
+
+    // Tampons de travail dimensionnés par le plus grand degré
+    int deg_max = 1;
+    for (int s = 0; s < n; s++) {
+        int deg = csr->debut[s + 1] - csr->debut[s];
+        if (deg > deg_max) deg_max = deg;
+    }
+    double *echelle = malloc(deg_max * sizeof(double));
+    int *petits = malloc(deg_max * sizeof(int));
+    int *grands = malloc(deg_max * sizeof(int));
+
+    for (int s = 0; s <= n; s++) tables->debut[s] = csr->debut[s];
+    for (int s = 0; s < n; s++) {
+        construire_ligne(csr, s, &tables->cases[csr->debut[s]], echelle, petits, grands);
+    }
+
+    free(echelle);
+    free(petits);
+    free(grands);
+    return tables;
+}
+
+//Fonction qui construit les tables d'alias directement depuis la liste d'adjacence
+t_alias* creer_alias(listeAdj *g) {
+    t_csr *csr = creer_csr(g);
+    t_alias *tables = creer_alias_csr(csr);
+    liberer_csr(csr);
+    return tables;
+}
+
+// Tire le successeur du sommet (indice C) à partir d'un réel uniforme u dans [0, 1[
+int alias_tirer(const t_alias *tables, int sommet, double u) {
+    int debut = tables->debut[sommet];
+    int deg = tables->debut[sommet + 1] - debut;
+
+    // Sommet sans arête sortante : il reste sur place
+    if (deg == 0) return sommet;
+
+    // La partie entière choisit la case, la partie fractionnaire décide case ou alias
+    double x = u * deg;
+    int k = (int)x;
+    if (k >= deg) k = deg - 1;
+    const t_case_alias *c = &tables->cases[debut + k];
+    return (x - k < c->seuil) ? c->arrivee : c->alias;
+}
+
+// Libère les tables d'alias
+void liberer_alias(t_alias *tables) {
+    if (tables == NULL) return;
+    free(tables->debut);
+    free(tables->cases);
+    free(tables);
+}
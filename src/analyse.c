@@ -0,0 +1,727 @@
+#include "analyse.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "list.h"
+#include "tarjan.h"
+#include "hasse.h"
+#include "matrix.h"
+#include "absorption.h"
+#include "propagation.h"
+#include "instrum.h"
+#include "simulation.h"
+#include "erreurs.h"
+#include "sortie.h"
+#include "cache_puissances.h"
+#include "agregation.h"
+#include "limite.h"
+#include "periode.h"
+#include "spectre.h"
+#include "compression.h"
+#include "renumerotation.h"
+
+// Au-delà de cette taille, les matrices et tables ne sont écrites qu'au niveau DETAIL
+#define TAILLE_MAX_AFFICHAGE 60
+
+// Précision et itérations maximales des systèmes résolus par classe (absorption, lois stationnaires)
+#define PRECISION_CLASSES 1e-10
+#define MAX_ITER_CLASSES 10000
+
+// Valeurs par défaut (identiques au mode interactif)
+void options_par_defaut(t_options *opt) {
+    opt->entree = NULL;
+    opt->dossier = NULL;
+    opt->fichier_init = NULL;
+    opt->sortie = NULL;
+    opt->puissances[0] = 1;
+    opt->nb_puissances = 1;
+    opt->cache_mo = 0;
+    opt->reprise = -1.0;
+    opt->epsilon = 0.01;
+    opt->tolerance = TOLERANCE_MARKOV;
+    opt->renormaliser = 0;
+    opt->max_iter = 1000;
+    opt->etapes = ETAPE_TOUTES;
+    opt->nb_threads = 1;
+    opt->profil = NULL;
+    opt->nb_marches = 100000;
+    opt->horizon = 100;
+    opt->graine = 42;
+    opt->sequences = NULL;
+    opt->chaine_estimee = "chaine_estimee.txt";
+    opt->format = FORMAT_TEXTE;
+    opt->niveau = NIVEAU_NORMAL;
+    opt->agregation = -1.0;
+    opt->compression = COMPRESSION_AUCUNE;
+    opt->ordre = ORDRE_ORIGINE;
+}
+
+// Extrait le nom de la chaîne (sans dossier ni extension .txt)
+static void extraire_nom_base(const char *chemin, char *nom, size_t taille) {
+    const char *debut = strrchr(chemin, '/');
+    const char *debut_win = strrchr(chemin, '\\');
+    if (debut_win != NULL && (debut == NULL || debut_win > debut)) debut = debut_win;
+    debut = (debut != NULL) ? debut + 1 : chemin;
+
+    snprintf(nom, taille, "%s", debut);
+    char *ext = strstr(nom, ".txt");
+    if (ext != NULL) *ext = '\0';
+}
+
+// Dossier où écrire les fichiers générés : --sortie, sinon le dossier de la chaîne
+static void extraire_dossier_sortie(const char *chemin, const t_options *opt, char *dossier, size_t taille) {
+    if (opt->sortie != NULL) {
+        snprintf(dossier, taille, "%s", opt->sortie);
+        return;
+    }
+    snprintf(dossier, taille, "%s", chemin);
+    char *fin = strrchr(dossier, '/');
+    char *fin_win = strrchr(dossier, '\\');
+    if (fin_win != NULL && (fin == NULL || fin_win > fin)) fin = fin_win;
+    if (fin != NULL) {
+        *fin = '\0';
+    } else {
+        snprintf(dossier, taille, ".");
+    }
+}
+
+// Lit les distributions initiales : N valeurs par distribution, renvoie une matrice K x N
+static t_matrix* lire_distributions(const char *nomFichier, int N) {
+    FILE *file = fopen(nomFichier, "rt");
+    if (file == NULL) {
+        return NULL;
+    }
+
+    int capacite = 16 * N;
+    int nb = 0;
+    double *valeurs = malloc(capacite * sizeof(double));
+    double v;
+    while (fscanf(file, "%lf", &v) == 1) {
+        if (nb >= capacite) {
+            capacite *= 2;
+            valeurs = realloc(valeurs, capacite * sizeof(double));
+        }
+        valeurs[nb++] = v;
+    }
+    fclose(file);
+
+    if (nb == 0 || nb % N != 0) {
+        free(valeurs);
+        return NULL;
+    }
+
+    int K = nb / N;
+    t_matrix *init = creer_matrice_valzeros(K, N);
+    for (int k = 0; k < K; k++) {
+        for (int i = 0; i < N; i++) {
+            init->data[k][i] = valeurs[(size_t)k * N + i];
+        }
+    }
+    free(valeurs);
+    return init;
+}
+
+// Vrai si une table ou une matrice de cette taille doit être écrite en entier
+static int ecrire_en_entier(t_sortie *sortie, int taille) {
+    return sortie_actif(sortie, NIVEAU_DETAIL) || (sortie_actif(sortie, NIVEAU_NORMAL) && taille <= TAILLE_MAX_AFFICHAGE);
+}
+
+// Écrit la table des classes (nom et sommets)
+static void ecrire_classes(t_sortie *sortie, t_partition *partition) {
+    sortie_debut_table(sortie, "classes");
+    for (int i = 0; i < partition->taille; i++) {
+        sortie_debut_ligne(sortie);
+        sortie_texte(sortie, "nom", partition->classes[i].nom);
+        sortie_liste_entiers(sortie, "sommets", partition->classes[i].sommets, partition->classes[i].taille);
+        sortie_fin_ligne(sortie);
+    }
+    sortie_fin_table(sortie);
+}
+
+// Limite du quotient relevée sur les états d'origine (sans agrégation : la matrice elle-même)
+static t_matrix* relever_limite(t_agregation *agr, t_matrix *L) {
+    if (agr == NULL || L == NULL) return L;
+    t_matrix *relevee = agregation_relever(agr, L);
+    liberer_matrice(L);
+    return relevee;
+}
+
+//Fonction qui exécute les étapes demandées sur une chaîne sans aucune saisie, renvoie 0 si tout s'est bien passé
+int analyser_chaine(const char *chemin, const t_options *opt, t_sortie *sortie, t_profil *profil) {
+    char nom[256];
+    char dossier[512];
+    char fichier[800];
+    char message[1024];
+    extraire_nom_base(chemin, nom, sizeof(nom));
+    extraire_dossier_sortie(chemin, opt, dossier, sizeof(dossier));
+    sortie_nommer_chaine(sortie, nom);
+
+    // Vérifier si le fichier existe et commence par un nombre de sommets avant de continuer
+    FILE *test = fopen(chemin, "r");
+    if (test == NULL) {
+        snprintf(message, sizeof(message), "Le fichier '%s' n'existe pas !", chemin);
+        sortie_erreur(sortie, message);
+        return 1;
+    }
+    int nb_lu;
+    int entete_ok = (fscanf(test, "%d", &nb_lu) == 1 && nb_lu > 0);
+    fclose(test);
+    if (!entete_ok) {
+        snprintf(message, sizeof(message), "'%s' n'est pas un fichier de chaine", chemin);
+        sortie_erreur(sortie, message);
+        return 1;
+    }
+
+    // La vérification est faite pendant la lecture, sans second parcours du graphe
+    listeAdj g;
+    long long E = 0;
+    int lecture = MARKOV_OK;
+    t_validation validation;
+    validation_init(&validation, opt->tolerance, opt->renormaliser);
+    int valider = (opt->etapes & ETAPE_VERIF) || opt->renormaliser;
+    PROFIL_ETAPE(profil, "chargement", g.nb_sommets, E) {
+        lecture = lireGrapheValide(chemin, &g, valider ? &validation : NULL);
+        for (int i = 0; i < g.nb_sommets; i++) {
+            for (cell *c = g.tab_liste[i].head; c != NULL; c = c->suivante) E++;
+        }
+    }
+    if (lecture != MARKOV_OK) {
+        snprintf(message, sizeof(message), "'%s' : %s", chemin, markov_message_erreur(lecture));
+        sortie_erreur(sortie, message);
+        return 1;
+    }
+    int N = g.nb_sommets;
+    int code = 0;
+    sortie_debut_chaine(sortie, nom, N, E);
+
+    // Liste des arêtes : seulement au niveau le plus détaillé
+    if (sortie_actif(sortie, NIVEAU_DETAIL)) {
+        sortie_debut_section(sortie, "graphe", "Liste d'adjacence");
+        sortie_debut_table(sortie, "aretes");
+        for (int i = 0; i < N; i++) {
+            for (cell *c = g.tab_liste[i].head; c != NULL; c = c->suivante) {
+                sortie_debut_ligne(sortie);
+                sortie_entier(sortie, "depart", i + 1);
+                sortie_entier(sortie, "arrivee", c->sommet_arrivee);
+                sortie_reel(sortie, "proba", c->proba);
+                sortie_fin_ligne(sortie);
+            }
+        }
+        sortie_fin_table(sortie);
+        sortie_fin_section(sortie);
+    }
+
+    if (opt->etapes & ETAPE_VERIF) {
+        sortie_debut_section(sortie, "verification", "Verification");
+        sortie_booleen(sortie, "markov", validation.markov);
+        sortie_reel(sortie, "tolerance", validation.tolerance);
+        sortie_reel(sortie, "ecart_max", validation.ecart_max);
+        sortie_entier(sortie, "nb_invalides", validation.nb_invalides);
+        if (validation.renormaliser) sortie_entier(sortie, "renormalisees", validation.nb_renormalisees);
+        if (validation.nb_invalides > 0 && sortie_actif(sortie, NIVEAU_NORMAL)) {
+            // Premiers sommets dont la somme des probabilités sortantes s'écarte de 1 (sommes lues)
+            sortie_debut_table(sortie, "sommets_invalides");
+            for (int k = 0; k < validation.nb_signales; k++) {
+                sortie_debut_ligne(sortie);
+                sortie_entier(sortie, "sommet", validation.signales[k]);
+                sortie_reel(sortie, "somme", validation.sommes[k]);
+                sortie_fin_ligne(sortie);
+            }
+            sortie_fin_table(sortie);
+        }
+        sortie_fin_section(sortie);
+    }
+
+    // La partition sert à la plupart des étapes suivantes
+    unsigned int besoin_partition = ETAPE_MERMAID | ETAPE_TARJAN | ETAPE_HASSE | ETAPE_CARAC | ETAPE_ABSORPTION
+                                  | ETAPE_CONVERGENCE | ETAPE_PERIODE | ETAPE_SIMULATION | ETAPE_SPECTRE;
+    t_partition *partition = NULL;
+    int agreger = opt->agregation >= 0.0 && (opt->etapes & (ETAPE_CONVERGENCE | ETAPE_PERIODE));
+
+    // Graphe compressé : remplace les listes pour la partition et la propagation
+    t_graphe_compresse *gc = NULL;
+    if (opt->compression != COMPRESSION_AUCUNE && ((opt->etapes & (besoin_partition | ETAPE_PUISSANCE)) || agreger))
+        PROFIL_ETAPE(profil, "compression", N, E) {
+        gc = compresser_graphe(&g, opt->compression);
+        if (gc != NULL) {
+            // Comparaison avec la matrice CSR (indice int et probabilité double par arête)
+            long long octets_csr = (long long)sizeof(t_csr) + ((long long)N + 1) * sizeof(int)
+                                 + E * (long long)(sizeof(int) + sizeof(double));
+            sortie_debut_section(sortie, "compression", "Graphe compresse");
+            sortie_texte(sortie, "probabilites", opt->compression == COMPRESSION_QUANTIFIEE ? "16 bits" : "float");
+            sortie_entier(sortie, "aretes", gc->nb_aretes);
+            sortie_entier(sortie, "octets", (long long)compresse_octets(gc));
+            sortie_entier(sortie, "octets_csr", octets_csr);
+            sortie_reel(sortie, "gain", (double)octets_csr / compresse_octets(gc));
+            sortie_fin_section(sortie);
+        }
+    }
+
+    if ((opt->etapes & besoin_partition) || agreger) PROFIL_ETAPE(profil, "tarjan", N, E) {
+        partition = (gc != NULL) ? compresse_partition(gc) : tarjan_calculer_partition(g);
+    }
+
+    if (opt->etapes & ETAPE_MERMAID) PROFIL_ETAPE(profil, "mermaid", N, E) {
+        snprintf(fichier, sizeof(fichier), "%s/%s_mermaid.txt", dossier, nom);
+        int ecriture = genererMermaidGraphe(&g, partition, fichier, SEUIL_CONDENSATION_MERMAID);
+        sortie_debut_section(sortie, "mermaid", "Graphe Mermaid");
+        sortie_texte(sortie, "fichier", fichier);
+        if (ecriture != MARKOV_OK) {
+            snprintf(message, sizeof(message), "'%s' : %s", fichier, markov_message_erreur(ecriture));
+            sortie_erreur(sortie, message);
+            code = 1;
+        }
+        sortie_fin_section(sortie);
+    }
+
+    if (opt->etapes & ETAPE_TARJAN) {
+        sortie_debut_section(sortie, "partition", "Partition");
+        sortie_entier(sortie, "nb_classes", partition->taille);
+        if (ecrire_en_entier(sortie, partition->taille)) ecrire_classes(sortie, partition);
+        sortie_fin_section(sortie);
+    }
+
+    if (opt->etapes & ETAPE_HASSE) PROFIL_ETAPE(profil, "hasse", N, E) {
+        int *corresp = creer_tab_corresp(partition, N);
+        t_link_array *liens = rencenser(&g, corresp);
+        snprintf(fichier, sizeof(fichier), "%s/%s_hasse.txt", dossier, nom);
+        sortie_debut_section(sortie, "hasse", "Liens entre les classes");
+        sortie_entier(sortie, "nb_liens", liens->log_size);
+        if (ecrire_en_entier(sortie, liens->log_size)) {
+            sortie_debut_table(sortie, "liens");
+            for (int i = 0; i < liens->log_size; i++) {
+                sortie_debut_ligne(sortie);
+                sortie_texte(sortie, "depart", partition->classes[liens->links[i].from].nom);
+                sortie_texte(sortie, "arrivee", partition->classes[liens->links[i].to].nom);
+                sortie_fin_ligne(sortie);
+            }
+            sortie_fin_table(sortie);
+        }
+        int ecriture = genererHasseMermaid(partition, liens, fichier, 0);
+        sortie_texte(sortie, "fichier", fichier);
+        if (ecriture != MARKOV_OK) {
+            snprintf(message, sizeof(message), "'%s' : %s", fichier, markov_message_erreur(ecriture));
+            sortie_erreur(sortie, message);
+            code = 1;
+        }
+        sortie_fin_section(sortie);
+        free(liens->links);
+        free(liens);
+        free(corresp);
+    }
+
+    if (opt->etapes & ETAPE_CARAC) PROFIL_ETAPE(profil, "caracteristiques", N, E) {
+        int *estPersistante = calculer_persistance(partition, &g);
+        int nb_persistantes = 0;
+        for (int i = 0; i < partition->taille; i++) nb_persistantes += estPersistante[i];
+
+        sortie_debut_section(sortie, "caracteristiques", "Caracteristiques");
+        sortie_booleen(sortie, "irreductible", partition->taille == 1);
+        sortie_entier(sortie, "nb_persistantes", nb_persistantes);
+        sortie_entier(sortie, "nb_transitoires", partition->taille - nb_persistantes);
+        if (ecrire_en_entier(sortie, partition->taille)) {
+            sortie_debut_table(sortie, "classes");
+            for (int i = 0; i < partition->taille; i++) {
+                sortie_debut_ligne(sortie);
+                sortie_texte(sortie, "nom", partition->classes[i].nom);
+                sortie_liste_entiers(sortie, "sommets", partition->classes[i].sommets, partition->classes[i].taille);
+                sortie_texte(sortie, "type", estPersistante[i] ? "persistante" : "transitoire");
+                sortie_booleen(sortie, "absorbant", estPersistante[i] && partition->classes[i].taille == 1);
+                sortie_fin_ligne(sortie);
+            }
+            sortie_fin_table(sortie);
+        }
+        sortie_fin_section(sortie);
+        free(estPersistante);
+    }
+
+    if (opt->etapes & ETAPE_ABSORPTION) PROFIL_ETAPE(profil, "absorption", N, E) {
+        t_absorption *abs = calculer_absorption(&g, partition, PRECISION_CLASSES, MAX_ITER_CLASSES);
+        int K = abs->nb_persistantes;
+        int *corresp = creer_tab_corresp(partition, N);
+        sortie_debut_section(sortie, "absorption", "Absorption");
+        sortie_entier(sortie, "balayages", abs->iterations);
+        sortie_reel(sortie, "residu", abs->residu);
+        if (ecrire_en_entier(sortie, N)) {
+            sortie_debut_table(sortie, "etats");
+            for (int i = 0; i < N; i++) {
+                if (abs->rang_persistante[corresp[i]] >= 0) continue;
+                sortie_debut_ligne(sortie);
+                sortie_entier(sortie, "etat", i + 1);
+                for (int k = 0; k < K; k++) {
+                    sortie_reel(sortie, partition->classes[abs->classes_persistantes[k]].nom, abs->proba[(size_t)i * K + k]);
+                }
+                sortie_reel(sortie, "temps_moyen", abs->temps[i]);
+                sortie_fin_ligne(sortie);
+            }
+            sortie_fin_table(sortie);
+        }
+        sortie_fin_section(sortie);
+        free(corresp);
+        liberer_absorption(abs);
+    }
+
+    if (opt->etapes & ETAPE_PUISSANCE) PROFIL_ETAPE(profil, "puissance", N, E) {
+        t_matrix *init = NULL;
+        if (opt->fichier_init != NULL) {
+            init = lire_distributions(opt->fichier_init, N);
+            if (init == NULL) {
+                snprintf(message, sizeof(message), "distributions initiales illisibles dans '%s' (%d valeurs par ligne attendues)",
+                         opt->fichier_init, N);
+                sortie_erreur(sortie, message);
+                code = 1;
+            }
+        } else {
+            // Sans fichier : distribution uniforme
+            init = creer_matrice_valzeros(1, N);
+            for (int i = 0; i < N; i++) init->data[0][i] = 1.0 / N;
+        }
+
+        // Renumérotation : la propagation tourne sur le graphe renuméroté (voisins proches en mémoire),
+        // les distributions reviennent ensuite aux numéros du fichier
+        t_permutation *perm = NULL;
+        listeAdj gp = {NULL, 0};
+        listeAdj *gprop = &g;
+        t_graphe_compresse *gcprop = gc;
+        if (init != NULL && opt->ordre != ORDRE_ORIGINE) {
+            perm = calculer_permutation(&g, partition, opt->ordre);
+            gp = permuter_graphe(&g, perm);
+            gprop = &gp;
+            t_matrix *init_renumerote = permuter_colonnes(init, perm, PERMUTER);
+            liberer_matrice(init);
+            init = init_renumerote;
+            if (gc != NULL) gcprop = compresser_graphe(&gp, opt->compression);
+
+            sortie_debut_section(sortie, "renumerotation", "Renumerotation des etats");
+            sortie_texte(sortie, "ordre", nom_ordre(opt->ordre));
+            sortie_reel(sortie, "ecart_moyen_avant", ecart_moyen(&g, NULL));
+            sortie_reel(sortie, "ecart_moyen_apres", ecart_moyen(&g, perm));
+            sortie_fin_section(sortie);
+        }
+
+        // Cache des carrés de M : rechargé depuis le fichier voisin de la chaîne, puis resauvegardé
+        t_cache_puissances *cache = NULL;
+        if (init != NULL && opt->cache_mo > 0) {
+            snprintf(fichier, sizeof(fichier), "%s/%s_puissances.bin", dossier, nom);
+            cache = creer_cache_puissances(gprop, (size_t)opt->cache_mo << 20);
+            cache_charger(cache, fichier);
+        }
+
+        // Points de reprise (sans cache) : un seul fichier par chaîne, le point d'un horizon sert au suivant
+        t_reprise reprise;
+        char fichier_reprise[800];
+        int avec_reprise = (cache == NULL && opt->reprise >= 0.0);
+        if (avec_reprise) {
+            snprintf(fichier_reprise, sizeof(fichier_reprise), "%s/%s_reprise.bin", dossier, nom);
+            reprise.fichier = fichier_reprise;
+            reprise.intervalle = opt->reprise;
+        }
+
+        for (int h = 0; init != NULL && h < opt->nb_puissances; h++) {
+            int n = opt->puissances[h];
+            t_matrix *finale;
+            if (cache != NULL) finale = cache_propager(cache, init, n);
+            else if (avec_reprise) finale = propager_distributions_reprise(gprop, init, n, &reprise);
+            else if (gcprop != NULL) finale = propager_distributions_compresse(gcprop, init, n);
+            else finale = propager_distributions(gprop, init, n);
+            if (perm != NULL) {
+                t_matrix *restauree = permuter_colonnes(finale, perm, RESTAURER);
+                liberer_matrice(finale);
+                finale = restauree;
+            }
+            char cle[64], titre[64];
+            snprintf(cle, sizeof(cle), "distributions_%d", n);
+            snprintf(titre, sizeof(titre), "Distributions apres %d transitions", n);
+            sortie_debut_section(sortie, cle, titre);
+            sortie_entier(sortie, "transitions", n);
+            sortie_entier(sortie, "scenarios", finale->lignes);
+            if (avec_reprise) {
+                sortie_entier(sortie, "reprise_depuis", reprise.reprise);
+                sortie_entier(sortie, "points_reprise", reprise.points);
+                sortie_texte(sortie, "fichier_reprise", reprise.code == MARKOV_OK ? fichier_reprise : "non sauvegarde");
+            }
+            if (ecrire_en_entier(sortie, N)) {
+                sortie_matrice(sortie, "distributions", finale);
+            } else if (sortie_actif(sortie, NIVEAU_NORMAL)) {
+                // Trop d'états : seulement l'état le plus probable de chaque scénario
+                sortie_debut_table(sortie, "scenarios");
+                for (int k = 0; k < finale->lignes; k++) {
+                    int etat_max = 0;
+                    for (int i = 1; i < N; i++) {
+                        if (finale->data[k][i] > finale->data[k][etat_max]) etat_max = i;
+                    }
+                    sortie_debut_ligne(sortie);
+                    sortie_entier(sortie, "scenario", k + 1);
+                    sortie_entier(sortie, "etat_max", etat_max + 1);
+                    sortie_reel(sortie, "proba", finale->data[k][etat_max]);
+                    sortie_fin_ligne(sortie);
+                }
+                sortie_fin_table(sortie);
+            }
+            sortie_fin_section(sortie);
+            liberer_matrice(finale);
+        }
+
+        if (cache != NULL) {
+            int sauvegarde = cache_sauvegarder(cache, fichier);
+            sortie_debut_section(sortie, "cache", "Cache des puissances");
+            sortie_entier(sortie, "trouvees", cache->trouvees);
+            sortie_entier(sortie, "calculees", cache->calculees);
+            sortie_entier(sortie, "evincees", cache->evincees);
+            sortie_entier(sortie, "octets", (long long)cache->occupe);
+            sortie_texte(sortie, "fichier", sauvegarde == MARKOV_OK ? fichier : "non sauvegarde");
+            sortie_fin_section(sortie);
+            liberer_cache_puissances(cache);
+        }
+        if (gcprop != gc) liberer_graphe_compresse(gcprop);
+        liberer_listeAdj(&gp);
+        liberer_permutation(perm);
+        if (init != NULL) liberer_matrice(init);
+    }
+
+    if (opt->etapes & ETAPE_SIMULATION) PROFIL_ETAPE(profil, "simulation", N, E) {
+        t_params_simulation params;
+        params_simulation_par_defaut(&params);
+        params.nb_marches = opt->nb_marches;
+        params.nb_pas = opt->horizon;
+        params.nb_threads = opt->nb_threads;
+        params.graine = opt->graine;
+
+        // Départ : première distribution du fichier initial, sinon distribution uniforme
+        t_matrix *init = (opt->fichier_init != NULL) ? lire_distributions(opt->fichier_init, N) : NULL;
+        if (opt->fichier_init != NULL && init == NULL) {
+            snprintf(message, sizeof(message), "distributions initiales illisibles dans '%s' (%d valeurs par ligne attendues)",
+                     opt->fichier_init, N);
+            sortie_erreur(sortie, message);
+            code = 1;
+        } else {
+            double *depart = malloc(N * sizeof(double));
+            for (int i = 0; i < N; i++) depart[i] = (init != NULL) ? init->data[0][i] : 1.0 / N;
+            params.distribution_init = depart;
+
+            t_resultat_simulation *sim = simuler_marches(&g, partition, &params);
+            double total_visites = 0.0;
+            for (int i = 0; i < N; i++) total_visites += (double)sim->visites[i];
+
+            sortie_debut_section(sortie, "simulation", "Simulation");
+            sortie_entier(sortie, "marches", sim->nb_marches);
+            sortie_entier(sortie, "pas", sim->nb_pas);
+            if (sim->nb_persistantes > 0) {
+                sortie_reel(sortie, "non_absorbees", (double)sim->nb_non_absorbees / (double)sim->nb_marches);
+            }
+            if (ecrire_en_entier(sortie, N)) {
+                sortie_debut_table(sortie, "etats");
+                for (int i = 0; i < N; i++) {
+                    sortie_debut_ligne(sortie);
+                    sortie_entier(sortie, "etat", i + 1);
+                    sortie_reel(sortie, "occupation", (total_visites > 0.0) ? sim->visites[i] / total_visites : 0.0);
+                    sortie_reel(sortie, "fin", (double)sim->fin[i] / (double)sim->nb_marches);
+                    if (sim->absorbees_depart[i] > 0) {
+                        sortie_reel(sortie, "temps_absorption", (double)sim->somme_temps[i] / (double)sim->absorbees_depart[i]);
+                    }
+                    sortie_fin_ligne(sortie);
+                }
+                sortie_fin_table(sortie);
+            }
+            if (ecrire_en_entier(sortie, sim->nb_persistantes)) {
+                sortie_debut_table(sortie, "absorptions");
+                for (int k = 0; k < sim->nb_persistantes; k++) {
+                    sortie_debut_ligne(sortie);
+                    sortie_texte(sortie, "classe", partition->classes[sim->classes_persistantes[k]].nom);
+                    sortie_reel(sortie, "frequence", (double)sim->absorptions[k] / (double)sim->nb_marches);
+                    sortie_fin_ligne(sortie);
+                }
+                sortie_fin_table(sortie);
+            }
+            sortie_fin_section(sortie);
+
+            liberer_simulation(sim);
+            free(depart);
+            if (init != NULL) liberer_matrice(init);
+        }
+    }
+
+    // Chaîne réduite pour les étapes matricielles : les blocs ne mélangent ni classes ni
+    // positions cycliques, la chaîne agrégée a donc les mêmes types de classes et périodes.
+    // Les résultats sont écrits pour les classes et les états d'origine (origine[c] : classe
+    // d'origine de la classe c du quotient)
+    listeAdj *gm = &g;
+    t_partition *pm = partition;
+    t_agregation *agr = NULL;
+    int *origine = NULL;
+    int Nm = N;
+    if (agreger) PROFIL_ETAPE(profil, "agregation", N, E) {
+        agr = agreger_chaine(&g, partition, opt->agregation);
+        if (agr == NULL) {
+            sortie_erreur(sortie, markov_message_erreur(MARKOV_ERR_MEMOIRE));
+            code = 1;
+        } else {
+            gm = &agr->quotient;
+            pm = tarjan_calculer_partition(agr->quotient);
+            Nm = agr->nb_blocs;
+            int *corresp = creer_tab_corresp(partition, N);
+            origine = malloc((pm->taille > 0 ? pm->taille : 1) * sizeof(int));
+            for (int c = 0; c < pm->taille; c++) {
+                int b = pm->classes[c].sommets[0] - 1;
+                origine[c] = corresp[agr->membres[agr->debut[b]] - 1];
+            }
+            free(corresp);
+
+            sortie_debut_section(sortie, "agregation", "Agregation des etats");
+            sortie_reel(sortie, "tolerance", agr->tolerance);
+            sortie_entier(sortie, "nb_blocs", agr->nb_blocs);
+            sortie_reel(sortie, "ecart", agr->ecart);
+            if (ecrire_en_entier(sortie, agr->nb_blocs)) {
+                sortie_debut_table(sortie, "blocs");
+                for (int b = 0; b < agr->nb_blocs; b++) {
+                    char nom_bloc[16];
+                    snprintf(nom_bloc, sizeof(nom_bloc), "B%d", b + 1);
+                    sortie_debut_ligne(sortie);
+                    sortie_texte(sortie, "nom", nom_bloc);
+                    sortie_liste_entiers(sortie, "sommets", agr->membres + agr->debut[b], agr->debut[b + 1] - agr->debut[b]);
+                    sortie_fin_ligne(sortie);
+                }
+                sortie_fin_table(sortie);
+            }
+            sortie_fin_section(sortie);
+        }
+    }
+
+    // Trou spectral : demandé explicitement, ou pour fixer le nombre d'itérations de la limite (-m auto)
+    t_spectre *spectre = NULL;
+    int max_iter = opt->max_iter;
+    if ((opt->etapes & ETAPE_SPECTRE) || ((opt->etapes & ETAPE_CONVERGENCE) && opt->max_iter == 0))
+        PROFIL_ETAPE(profil, "spectre", Nm, E) {
+        spectre = estimer_spectre(gm, pm, DIMENSION_KRYLOV);
+        // Marge de 2 sur la prévision : les valeurs de Ritz sous-estiment un peu le SLEM
+        int prevues = spectre_iterations_limite(spectre, PRECISION_CLASSES);
+        if (max_iter == 0) max_iter = (prevues > 0 && prevues < MAX_ITER_CLASSES / 2) ? 2 * prevues + 10 : MAX_ITER_CLASSES;
+    }
+    if ((opt->etapes & ETAPE_SPECTRE) && spectre != NULL) {
+        sortie_debut_section(sortie, "spectre", "Trou spectral");
+        sortie_entier(sortie, "produits", spectre->produits);
+        sortie_entier(sortie, "iterations_prevues", spectre_iterations_limite(spectre, PRECISION_CLASSES));
+        if (ecrire_en_entier(sortie, spectre->nb_classes)) {
+            sortie_debut_table(sortie, "classes");
+            for (int k = 0; k < spectre->nb_classes; k++) {
+                sortie_debut_ligne(sortie);
+                int c = spectre->classes[k];
+                t_classe *classe = (origine != NULL) ? &partition->classes[origine[c]] : &pm->classes[c];
+                sortie_texte(sortie, "nom", classe->nom);
+                sortie_entier(sortie, "taille", classe->taille);
+                sortie_entier(sortie, "dimension", spectre->dimension[k]);
+                sortie_reel(sortie, "slem", spectre->slem[k]);
+                sortie_reel(sortie, "trou", 1.0 - spectre->slem[k]);
+                // Temps de mélange pour l'epsilon demandé (-1 : classe périodique, ne mélange pas)
+                sortie_entier(sortie, "melange", spectre_temps_melange(spectre->slem[k], opt->epsilon));
+                sortie_reel(sortie, "slem_paresseuse", spectre->slem_paresseuse[k]);
+                sortie_fin_ligne(sortie);
+            }
+            sortie_fin_table(sortie);
+        }
+        sortie_fin_section(sortie);
+    }
+
+    if (opt->etapes & ETAPE_CONVERGENCE) PROFIL_ETAPE(profil, "convergence", Nm, E) {
+        // Limite par classes de Tarjan : aucun produit de matrices N x N
+        t_limite *lim = calculer_limite(gm, pm, PRECISION_CLASSES, max_iter);
+        double diff = lim->residu;
+        sortie_debut_section(sortie, "convergence", "Convergence");
+        sortie_reel(sortie, "epsilon", opt->epsilon);
+        sortie_entier(sortie, "periode", lim->periode);
+        // Classe persistante périodique : M^k ne converge pas, seules ses sous-suites de pas d convergent
+        sortie_booleen(sortie, "atteinte", diff <= opt->epsilon && lim->periode == 1);
+        sortie_entier(sortie, "iterations", lim->iterations);
+        if (opt->max_iter == 0) sortie_entier(sortie, "max_iter", max_iter);
+        sortie_reel(sortie, "difference", diff);
+
+        if (lim->periode > 1 && ecrire_en_entier(sortie, lim->absorption->nb_persistantes)) {
+            // Sous-classes cycliques de chaque classe persistante périodique
+            sortie_debut_table(sortie, "cycles");
+            for (int k = 0; k < lim->absorption->nb_persistantes; k++) {
+                int d = lim->periode_classe[k];
+                if (d == 1) continue;
+                int c = lim->absorption->classes_persistantes[k];
+                t_classe *classe = (origine != NULL) ? &partition->classes[origine[c]] : &pm->classes[c];
+                int *membres = malloc(classe->taille * sizeof(int));
+                sortie_debut_ligne(sortie);
+                sortie_texte(sortie, "classe", classe->nom);
+                sortie_entier(sortie, "periode", d);
+                for (int a = 0; a < d; a++) {
+                    char cle[32];
+                    int nb = 0;
+                    for (int s = 0; s < classe->taille; s++) {
+                        int v = classe->sommets[s] - 1;
+                        if (lim->position[(agr != NULL) ? agr->bloc[v] : v] == a) membres[nb++] = v + 1;
+                    }
+                    snprintf(cle, sizeof(cle), "position_%d", a);
+                    sortie_liste_entiers(sortie, cle, membres, nb);
+                }
+                sortie_fin_ligne(sortie);
+                free(membres);
+            }
+            sortie_fin_table(sortie);
+        }
+
+        if (diff <= opt->epsilon && ecrire_en_entier(sortie, N)) {
+            t_matrix *L = relever_limite(agr, limite_matrice(lim));
+            sortie_matrice(sortie, lim->periode == 1 ? "stationnaire" : "cesaro", L);
+            liberer_matrice(L);
+        }
+        if (lim->periode > 1 && diff <= opt->epsilon && ecrire_en_entier(sortie, N * lim->periode)) {
+            // Limite de M^(k d + r) pour chaque phase r ; relevée, M^(k d + r) = A Q^(k d + r - 1) R
+            for (int r = 0; r < lim->periode; r++) {
+                char cle[32];
+                snprintf(cle, sizeof(cle), "cycle_%d", r);
+                int phase = (agr != NULL) ? (r + lim->periode - 1) % lim->periode : r;
+                t_matrix *L = relever_limite(agr, limite_matrice_cyclique(lim, phase));
+                sortie_matrice(sortie, cle, L);
+                liberer_matrice(L);
+            }
+        }
+        sortie_fin_section(sortie);
+        liberer_limite(lim);
+    }
+
+    if (opt->etapes & ETAPE_PERIODE) PROFIL_ETAPE(profil, "periode", Nm, E) {
+        sortie_debut_section(sortie, "periodes", "Periodes");
+        // Parcours en largeur par classe : ni matrice dense ni puissances de sous-matrices
+        int *periodes = malloc((pm->taille > 0 ? pm->taille : 1) * sizeof(int));
+        calculer_periodes(gm, pm, periodes, NULL);
+        int ecrire = ecrire_en_entier(sortie, pm->taille);
+        int nb_periodiques = 0;
+        // Avec agrégation, classes écrites dans l'ordre des classes d'origine
+        int *ordre = malloc((pm->taille > 0 ? pm->taille : 1) * sizeof(int));
+        for (int c = 0; c < pm->taille; c++) ordre[(origine != NULL) ? origine[c] : c] = c;
+        if (ecrire) sortie_debut_table(sortie, "classes");
+        for (int k = 0; k < pm->taille; k++) {
+            int c = ordre[k];
+            int periode = periodes[c];
+            if (periode > 1) nb_periodiques++;
+            if (ecrire) {
+                sortie_debut_ligne(sortie);
+                sortie_texte(sortie, "nom", (origine != NULL) ? partition->classes[origine[c]].nom : pm->classes[c].nom);
+                sortie_entier(sortie, "periode", periode);
+                sortie_texte(sortie, "type", periode == 1 ? "aperiodique" : (periode > 1 ? "periodique" : "aucun retour"));
+                sortie_fin_ligne(sortie);
+            }
+        }
+        if (ecrire) sortie_fin_table(sortie);
+        sortie_entier(sortie, "nb_periodiques", nb_periodiques);
+        free(periodes);
+        free(ordre);
+        sortie_fin_section(sortie);
+    }
+
+    sortie_fin_chaine(sortie);
+    liberer_spectre(spectre);
+    liberer_graphe_compresse(gc);
+    if (agr != NULL) {
+        liberer_partition(pm);
+        liberer_agregation(agr);
+        free(origine);
+    }
+    liberer_partition(partition);
+    liberer_listeAdj(&g);
+    return code;
+}
@@ -0,0 +1,233 @@
+#include "analyse_classes.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+#include "hasse.h"
+#include "limite.h"
+#include "periode.h"
+#include "erreurs.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+/** File de tâches d'un thread : indices de classes taches[debut..fin-1], les plus grosses d'abord.
+Le propriétaire prend au début (grosses classes), un thread sans travail vole à la fin (petites
+classes) : les vols équilibrent la fin de l'analyse sans gêner le propriétaire.
+**/
+typedef struct {
+    int *taches;
+    int debut;
+    int fin;
+    pthread_mutex_t verrou;
+} t_file_taches;
+
+/** Données partagées par les threads (lecture seule sauf les files, les cases de résultats et les
+tableaux pi / suivant indexés par sommet : chaque case n'est écrite que par le thread qui a pris la classe)
+**/
+typedef struct {
+    listeAdj *g;
+    t_partition *partition;
+    const int *corresp;
+    double epsilon;
+    int max_iter;
+    double *pi;
+    double *suivant;
+    t_file_taches *files;
+    int nb_threads;
+    t_analyse_classes *res;
+} t_contexte_classes;
+
+// Travail d'un thread : sa file et son compteur de vols
+typedef struct {
+    t_contexte_classes *ctx;
+    int id;
+    int nb_vols;
+} t_travail_classes;
+
+// Nombre de processeurs en ligne (1 si inconnu)
+int nb_processeurs(void) {
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (info.dwNumberOfProcessors > 0) ? (int)info.dwNumberOfProcessors : 1;
+#else
+    long nb = sysconf(_SC_NPROCESSORS_ONLN);
+    return (nb > 0) ? (int)nb : 1;
+#endif
+}
+
+// Analyse de la classe c, sauf la période (ne lit que le graphe, n'écrit que dans res et dans les
+// cases de la classe de pi / suivant)
+static void analyser_une_classe(const t_contexte_classes *ctx, int c, t_analyse_classe *res) {
+    t_classe *classe = &ctx->partition->classes[c];
+    listeAdj *g = ctx->g;
+
+    // Statistiques : les lignes de la classe, en entier (arêtes internes et sortantes)
+    double interne = 0.0;
+    for (int s = 0; s < classe->taille; s++) {
+        double dedans = 0.0, dehors = 0.0;
+        for (cell *e = g->tab_liste[classe->sommets[s] - 1].head; e != NULL; e = e->suivante) {
+            if (e->proba <= 0.0f) continue;
+            if (ctx->corresp[e->sommet_arrivee - 1] == c) {
+                res->aretes_internes++;
+                dedans += e->proba;
+            } else {
+                res->aretes_sortantes++;
+                dehors += e->proba;
+            }
+        }
+        interne += dedans;
+        if (dehors > res->masse_sortante_max) res->masse_sortante_max = dehors;
+    }
+    res->masse_interne = interne / classe->taille;
+    res->persistante = (res->aretes_sortantes == 0);
+    if (!res->persistante) return;
+
+    // Loi stationnaire (même itération que la limite), recopiée dans l'ordre des sommets de la classe
+    res->iterations = stationnaire_classe(g, classe, ctx->pi, ctx->suivant, ctx->epsilon, ctx->max_iter,
+                                          &res->residu);
+    res->stationnaire = malloc(classe->taille * sizeof(double));
+    for (int s = 0; s < classe->taille; s++) res->stationnaire[s] = ctx->pi[classe->sommets[s] - 1];
+}
+
+// Prend une tâche dans la file f, au début (propriétaire) ou à la fin (vol) ; -1 si elle est vide
+static int prendre_tache(t_file_taches *f, int voler) {
+    int c = -1;
+    pthread_mutex_lock(&f->verrou);
+    if (f->debut < f->fin) c = voler ? f->taches[--f->fin] : f->taches[f->debut++];
+    pthread_mutex_unlock(&f->verrou);
+    return c;
+}
+
+// Boucle d'un thread : vide sa file, puis vole chez les autres jusqu'à ce que toutes soient vides
+static void* thread_classes(void *arg) {
+    t_travail_classes *travail = arg;
+    t_contexte_classes *ctx = travail->ctx;
+    int T = ctx->nb_threads;
+
+    for (;;) {
+        int c = prendre_tache(&ctx->files[travail->id], 0);
+        // Aucune tâche n'est créée pendant l'analyse : un tour complet sans succès termine le thread
+        for (int k = 1; c < 0 && k < T; k++) {
+            c = prendre_tache(&ctx->files[(travail->id + k) % T], 1);
+            if (c >= 0) travail->nb_vols++;
+        }
+        if (c < 0) break;
+        analyser_une_classe(ctx, c, &ctx->res->classes[c]);
+    }
+    return NULL;
+}
+
+// Classe à distribuer, triée par taille décroissante (à taille égale, par indice)
+typedef struct {
+    int taille;
+    int classe;
+} t_tache;
+
+static int comparer_taches(const void *a, const void *b) {
+    const t_tache *x = a, *y = b;
+    if (x->taille != y->taille) return (x->taille < y->taille) - (x->taille > y->taille);
+    return (x->classe > y->classe) - (x->classe < y->classe);
+}
+
+//Fonction qui analyse toutes les classes (période, loi stationnaire des classes persistantes, statistiques
+//de la sous-matrice). Les périodes sont calculées en une passe sur le graphe ; le reste est distribué par
+//taille de classe décroissante sur nb_threads files (<= 0 : un thread par processeur) avec vol de tâches.
+//Les résultats sont rangés par classe
+t_analyse_classes* analyser_classes(listeAdj *g, t_partition *partition, double epsilon, int max_iter, int nb_threads) {
+    if (g == NULL || partition == NULL) return NULL;
+    int nb = partition->taille;
+    int n = g->nb_sommets;
+
+    t_analyse_classes *res = malloc(sizeof(t_analyse_classes));
+    res->nb_classes = nb;
+    res->classes = calloc(nb > 0 ? nb : 1, sizeof(t_analyse_classe));
+    res->nb_vols = 0;
+
+    // Périodes de toutes les classes par parcours en largeur (O(N + E))
+    int *periodes = malloc((nb > 0 ? nb : 1) * sizeof(int));
+    int code = calculer_periodes(g, partition, periodes, NULL);
+    for (int c = 0; c < nb; c++) res->classes[c].periode = (code == MARKOV_OK) ? periodes[c] : -1;
+    free(periodes);
+
+    if (nb_threads <= 0) nb_threads = nb_processeurs();
+    if (nb_threads > nb) nb_threads = (nb > 0) ? nb : 1;
+    res->nb_threads = nb_threads;
+
+    // Tri par taille : le coût d'une classe croît avec sa taille, les grosses passent en premier
+    t_tache *ordre = malloc((nb > 0 ? nb : 1) * sizeof(t_tache));
+    for (int c = 0; c < nb; c++) {
+        ordre[c].taille = partition->classes[c].taille;
+        ordre[c].classe = c;
+    }
+    qsort(ordre, nb, sizeof(t_tache), comparer_taches);
+
+    t_contexte_classes ctx;
+    ctx.g = g;
+    ctx.partition = partition;
+    ctx.corresp = creer_tab_corresp(partition, n);
+    ctx.epsilon = epsilon;
+    ctx.max_iter = max_iter;
+    ctx.pi = malloc((n > 0 ? n : 1) * sizeof(double));
+    ctx.suivant = malloc((n > 0 ? n : 1) * sizeof(double));
+    ctx.nb_threads = nb_threads;
+    ctx.res = res;
+
+    // Distribution tournante : chaque file reçoit des classes de toutes les tailles, les plus grosses d'abord
+    ctx.files = malloc(nb_threads * sizeof(t_file_taches));
+    for (int t = 0; t < nb_threads; t++) {
+        ctx.files[t].taches = malloc((nb / nb_threads + 1) * sizeof(int));
+        ctx.files[t].debut = 0;
+        ctx.files[t].fin = 0;
+        pthread_mutex_init(&ctx.files[t].verrou, NULL);
+    }
+    for (int k = 0; k < nb; k++) {
+        t_file_taches *f = &ctx.files[k % nb_threads];
+        f->taches[f->fin++] = ordre[k].classe;
+    }
+    free(ordre);
+
+    t_travail_classes *travaux = malloc(nb_threads * sizeof(t_travail_classes));
+    pthread_t *threads = malloc(nb_threads * sizeof(pthread_t));
+    for (int t = 0; t < nb_threads; t++) {
+        travaux[t].ctx = &ctx;
+        travaux[t].id = t;
+        travaux[t].nb_vols = 0;
+    }
+    // Le thread appelant prend la première file. Un thread qui ne démarre pas n'est pas attendu :
+    // sa file est vidée par les vols des autres
+    char *demarre = calloc(nb_threads, sizeof(char));
+    for (int t = 1; t < nb_threads; t++) {
+        demarre[t] = (pthread_create(&threads[t], NULL, thread_classes, &travaux[t]) == 0);
+    }
+    thread_classes(&travaux[0]);
+    for (int t = 1; t < nb_threads; t++) {
+        if (demarre[t]) pthread_join(threads[t], NULL);
+    }
+    free(demarre);
+
+    for (int t = 0; t < nb_threads; t++) {
+        res->nb_vols += travaux[t].nb_vols;
+        pthread_mutex_destroy(&ctx.files[t].verrou);
+        free(ctx.files[t].taches);
+    }
+    free(threads);
+    free(travaux);
+    free(ctx.files);
+    free(ctx.suivant);
+    free(ctx.pi);
+    free((int*)ctx.corresp);
+    return res;
+}
+
+// Libère les analyses et les lois stationnaires
+void liberer_analyse_classes(t_analyse_classes *res) {
+    if (res == NULL) return;
+    for (int c = 0; c < res->nb_classes; c++) free(res->classes[c].stationnaire);
+    free(res->classes);
+    free(res);
+}
@@ -0,0 +1,334 @@
+#include "cache_puissances.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "erreurs.h"
+
+/* Cache des carrés successifs M, M^2, M^4, ..., M^(2^i). Une requête M^n ou
+ * pi.M^n est composée à partir des carrés correspondant aux bits de n : au
+ * plus log2(n) produits, et les carrés déjà calculés servent à toutes les
+ * requêtes suivantes (plusieurs horizons sur une même chaîne).
+ * Chaque carré est gardé au format creux tant que sa densité reste faible.
+ * Quand le budget mémoire est dépassé, le carré le moins récemment utilisé
+ * est évincé (il sera recalculé à partir du plus grand carré restant).
+ *
+ * Fichier de sauvegarde (binaire, ordre des octets de la machine) :
+ *   "MKVPUISS", version, nombre de sommets, signature de la chaîne,
+ *   nombre de carrés, puis pour chaque carré : niveau, format (0 dense,
+ *   1 creux) et ses données (N*N réels, ou nb_aretes, debut, arrivee, proba).
+ */
+
+#define CACHE_MAGIQUE "MKVPUISS"
+#define CACHE_VERSION 1
+
+static size_t taille_dense(int n) {
+    return (size_t)n * n * sizeof(double) + (size_t)n * sizeof(double*);
+}
+
+static size_t taille_creuse(int n, int nb_aretes) {
+    return (size_t)(n + 1) * sizeof(int) + (size_t)nb_aretes * (sizeof(int) + sizeof(double));
+}
+
+static int est_present(const t_puissance *p) {
+    return p->dense != NULL || p->creuse != NULL;
+}
+
+// Matrice creuse des coefficients non nuls d'une matrice dense
+static t_csr* csr_depuis_dense(t_matrix *m, int nb_non_nuls) {
+    int n = m->lignes;
+    t_csr *csr = malloc(sizeof(t_csr));
+    csr->nb_sommets = n;
+    csr->nb_aretes = nb_non_nuls;
+    csr->debut = malloc((n + 1) * sizeof(int));
+    csr->arrivee = malloc((nb_non_nuls > 0 ? nb_non_nuls : 1) * sizeof(int));
+    csr->proba = malloc((nb_non_nuls > 0 ? nb_non_nuls : 1) * sizeof(double));
+
+    int e = 0;
+    for (int i = 0; i < n; i++) {
+        csr->debut[i] = e;
+        for (int j = 0; j < m->cols; j++) {
+            if (m->data[i][j] == 0.0) continue;
+            csr->arrivee[e] = j;
+            csr->proba[e] = m->data[i][j];
+            e++;
+        }
+    }
+    csr->debut[n] = e;
+    return csr;
+}
+
+static t_matrix* dense_depuis_csr(const t_csr *csr) {
+    t_matrix *m = creer_matrice_valzeros(csr->nb_sommets, csr->nb_sommets);
+    for (int i = 0; i < csr->nb_sommets; i++) {
+        for (int e = csr->debut[i]; e < csr->debut[i + 1]; e++) {
+            m->data[i][csr->arrivee[e]] += csr->proba[e];
+        }
+    }
+    return m;
+}
+
+static void vider_niveau(t_puissance *p) {
+    if (p->dense != NULL) liberer_matrice(p->dense);
+    liberer_csr(p->creuse);
+    p->dense = NULL;
+    p->creuse = NULL;
+    p->octets = 0;
+}
+
+// Évince les carrés les moins récemment utilisés tant que le budget est dépassé (M et le niveau "garder" restent)
+static void evincer(t_cache_puissances *cache, int garder) {
+    while (cache->occupe > cache->budget) {
+        int victime = -1;
+        for (int i = 1; i < CACHE_MAX_NIVEAUX; i++) {
+            t_puissance *p = &cache->niveaux[i];
+            if (i == garder || !est_present(p)) continue;
+            if (victime < 0 || p->utilisation < cache->niveaux[victime].utilisation) victime = i;
+        }
+        if (victime < 0) break;
+        cache->occupe -= cache->niveaux[victime].octets;
+        vider_niveau(&cache->niveaux[victime]);
+        cache->evincees++;
+    }
+}
+
+// Range un carré (une seule des deux formes) et fait de la place si besoin
+static void inserer(t_cache_puissances *cache, int niveau, t_matrix *dense, t_csr *creuse) {
+    t_puissance *p = &cache->niveaux[niveau];
+    if (est_present(p)) {
+        cache->occupe -= p->octets;
+        vider_niveau(p);
+    }
+    p->dense = dense;
+    p->creuse = creuse;
+    p->octets = (dense != NULL) ? taille_dense(cache->nb_sommets) : taille_creuse(cache->nb_sommets, creuse->nb_aretes);
+    p->utilisation = ++cache->horloge;
+    cache->occupe += p->octets;
+    evincer(cache, niveau);
+}
+
+// Range une puissance calculée (dense) au format le plus compact ; le cache en devient propriétaire
+static void ranger(t_cache_puissances *cache, int niveau, t_matrix *m) {
+    int n = cache->nb_sommets;
+    long long nb_non_nuls = 0;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) nb_non_nuls += (m->data[i][j] != 0.0);
+    }
+
+    if (nb_non_nuls < CACHE_DENSITE_CREUSE * (double)n * n) {
+        t_csr *csr = csr_depuis_dense(m, (int)nb_non_nuls);
+        liberer_matrice(m);
+        inserer(cache, niveau, NULL, csr);
+    } else {
+        inserer(cache, niveau, m, NULL);
+    }
+}
+
+// Produit X.P (X dense de N colonnes), renvoie une nouvelle matrice
+static t_matrix* multiplier_par(t_matrix *X, const t_puissance *p) {
+    if (p->dense != NULL) {
+        return multiplication_matrice(X, p->dense);
+    }
+    const t_csr *csr = p->creuse;
+    t_matrix *Y = creer_matrice_valzeros(X->lignes, csr->nb_sommets);
+    for (int r = 0; r < X->lignes; r++) {
+        const double *x = X->data[r];
+        double *y = Y->data[r];
+        for (int i = 0; i < csr->nb_sommets; i++) {
+            double xi = x[i];
+            if (xi == 0.0) continue;
+            for (int e = csr->debut[i]; e < csr->debut[i + 1]; e++) {
+                y[csr->arrivee[e]] += xi * csr->proba[e];
+            }
+        }
+    }
+    return Y;
+}
+
+// Renvoie M^(2^niveau), calculé par carrés successifs depuis le plus grand carré en cache au-dessous
+static t_puissance* obtenir_niveau(t_cache_puissances *cache, int niveau) {
+    t_puissance *p = &cache->niveaux[niveau];
+    if (est_present(p)) {
+        cache->trouvees++;
+        p->utilisation = ++cache->horloge;
+        return p;
+    }
+
+    int k = niveau - 1;
+    while (!est_present(&cache->niveaux[k])) k--;
+    for (; k < niveau; k++) {
+        t_puissance *base = &cache->niveaux[k];
+        base->utilisation = ++cache->horloge;
+        t_matrix *X = (base->dense != NULL) ? base->dense : dense_depuis_csr(base->creuse);
+        t_matrix *carre = multiplier_par(X, base);
+        if (X != base->dense) liberer_matrice(X);
+        ranger(cache, k + 1, carre);
+        cache->calculees++;
+    }
+    return p;
+}
+
+// Compose init.M^n (init NULL : M^n) à partir des carrés correspondant aux bits de n
+static t_matrix* composer(t_cache_puissances *cache, t_matrix *init, int n) {
+    t_matrix *X = NULL;
+    if (init != NULL) {
+        X = creer_matrice_valzeros(init->lignes, init->cols);
+        copie_matrice(init, X);
+    }
+
+    for (int i = 0; i < CACHE_MAX_NIVEAUX && (n >> i) != 0; i++) {
+        if (!((n >> i) & 1)) continue;
+        t_puissance *p = obtenir_niveau(cache, i);
+        if (X == NULL) {
+            // Premier facteur de M^n : copie du carré
+            X = (p->dense != NULL) ? creer_matrice_valzeros(cache->nb_sommets, cache->nb_sommets) : dense_depuis_csr(p->creuse);
+            if (p->dense != NULL) copie_matrice(p->dense, X);
+            continue;
+        }
+        t_matrix *Y = multiplier_par(X, p);
+        liberer_matrice(X);
+        X = Y;
+    }
+
+    // M^0 : identité
+    if (X == NULL) {
+        X = creer_matrice_valzeros(cache->nb_sommets, cache->nb_sommets);
+        for (int i = 0; i < cache->nb_sommets; i++) X->data[i][i] = 1.0;
+    }
+    return X;
+}
+
+//Fonction qui crée un cache vide pour la chaîne g (budget en octets, M elle-même compte dans le budget)
+t_cache_puissances* creer_cache_puissances(listeAdj *g, size_t budget_octets) {
+    t_cache_puissances *cache = calloc(1, sizeof(t_cache_puissances));
+    int n = g->nb_sommets;
+    cache->nb_sommets = n;
+    cache->budget = budget_octets;
+
+    t_csr *csr = creer_csr(g);
+    cache->signature = csr_signature(csr);
+    if (csr->nb_aretes < CACHE_DENSITE_CREUSE * (double)n * n) {
+        inserer(cache, 0, NULL, csr);
+    } else {
+        liberer_csr(csr);
+        inserer(cache, 0, creer_matrice_liste_adjacence(g), NULL);
+    }
+    return cache;
+}
+
+//Fonction qui renvoie M^n (nouvelle matrice à libérer), NULL si n est négatif
+t_matrix* cache_puissance(t_cache_puissances *cache, int n) {
+    if (n < 0) return NULL;
+    return composer(cache, NULL, n);
+}
+
+//Fonction qui propage K distributions (matrice K x N) sur n transitions : init.M^n
+t_matrix* cache_propager(t_cache_puissances *cache, t_matrix *init, int n) {
+    if (n < 0 || init == NULL || init->cols != cache->nb_sommets) return NULL;
+    return composer(cache, init, n);
+}
+
+// Écrit les carrés calculés (M n'est pas sauvegardée : elle vient du fichier de la chaîne)
+int cache_sauvegarder(t_cache_puissances *cache, const char *nomFichier) {
+    FILE *f = fopen(nomFichier, "wb");
+    if (f == NULL) return MARKOV_ERR_FICHIER;
+
+    int n = cache->nb_sommets;
+    int version = CACHE_VERSION;
+    int nb = 0;
+    for (int i = 1; i < CACHE_MAX_NIVEAUX; i++) nb += est_present(&cache->niveaux[i]);
+
+    int ok = fwrite(CACHE_MAGIQUE, 1, 8, f) == 8
+          && fwrite(&version, sizeof(int), 1, f) == 1
+          && fwrite(&n, sizeof(int), 1, f) == 1
+          && fwrite(&cache->signature, sizeof(cache->signature), 1, f) == 1
+          && fwrite(&nb, sizeof(int), 1, f) == 1;
+
+    for (int i = 1; ok && i < CACHE_MAX_NIVEAUX; i++) {
+        t_puissance *p = &cache->niveaux[i];
+        if (!est_present(p)) continue;
+        int format = (p->creuse != NULL);
+        ok = fwrite(&i, sizeof(int), 1, f) == 1 && fwrite(&format, sizeof(int), 1, f) == 1;
+        if (ok && p->dense != NULL) {
+            for (int r = 0; ok && r < n; r++) ok = fwrite(p->dense->data[r], sizeof(double), n, f) == (size_t)n;
+        } else if (ok) {
+            size_t m = p->creuse->nb_aretes;
+            ok = fwrite(&p->creuse->nb_aretes, sizeof(int), 1, f) == 1
+              && fwrite(p->creuse->debut, sizeof(int), n + 1, f) == (size_t)(n + 1)
+              && fwrite(p->creuse->arrivee, sizeof(int), m, f) == m
+              && fwrite(p->creuse->proba, sizeof(double), m, f) == m;
+        }
+    }
+
+    if (fclose(f) != 0) ok = 0;
+    return ok ? MARKOV_OK : MARKOV_ERR_FICHIER;
+}
+
+// Lit un carré creux, NULL si le fichier est tronqué ou incohérent
+static t_csr* lire_creuse(FILE *f, int n) {
+    int m;
+    if (fread(&m, sizeof(int), 1, f) != 1 || m < 0) return NULL;
+    t_csr *csr = malloc(sizeof(t_csr));
+    csr->nb_sommets = n;
+    csr->nb_aretes = m;
+    csr->debut = malloc((n + 1) * sizeof(int));
+    csr->arrivee = malloc((m > 0 ? m : 1) * sizeof(int));
+    csr->proba = malloc((m > 0 ? m : 1) * sizeof(double));
+    int ok = fread(csr->debut, sizeof(int), n + 1, f) == (size_t)(n + 1)
+          && fread(csr->arrivee, sizeof(int), m, f) == (size_t)m
+          && fread(csr->proba, sizeof(double), m, f) == (size_t)m
+          && csr->debut[0] == 0 && csr->debut[n] == m;
+    for (int i = 0; ok && i < n; i++) ok = csr->debut[i] <= csr->debut[i + 1];
+    for (int e = 0; ok && e < m; e++) ok = csr->arrivee[e] >= 0 && csr->arrivee[e] < n;
+    if (!ok) {
+        liberer_csr(csr);
+        return NULL;
+    }
+    return csr;
+}
+
+//Fonction qui recharge les carrés sauvegardés pour la même chaîne (même signature), dans la limite du budget
+int cache_charger(t_cache_puissances *cache, const char *nomFichier) {
+    FILE *f = fopen(nomFichier, "rb");
+    if (f == NULL) return MARKOV_ERR_FICHIER;
+
+    char magique[8];
+    int version, n, nb;
+    unsigned long long signature;
+    int ok = fread(magique, 1, 8, f) == 8 && memcmp(magique, CACHE_MAGIQUE, 8) == 0
+          && fread(&version, sizeof(int), 1, f) == 1 && version == CACHE_VERSION
+          && fread(&n, sizeof(int), 1, f) == 1
+          && fread(&signature, sizeof(signature), 1, f) == 1
+          && fread(&nb, sizeof(int), 1, f) == 1;
+    if (!ok || n != cache->nb_sommets || signature != cache->signature) {
+        // Fichier d'une autre chaîne (ou d'une version modifiée de celle-ci) : ignoré
+        fclose(f);
+        return MARKOV_ERR_FORMAT;
+    }
+
+    for (int k = 0; ok && k < nb; k++) {
+        int niveau, format;
+        ok = fread(&niveau, sizeof(int), 1, f) == 1 && fread(&format, sizeof(int), 1, f) == 1
+          && niveau >= 1 && niveau < CACHE_MAX_NIVEAUX;
+        if (!ok) break;
+        if (format == 0) {
+            t_matrix *m = creer_matrice_valzeros(n, n);
+            for (int r = 0; ok && r < n; r++) ok = fread(m->data[r], sizeof(double), n, f) == (size_t)n;
+            if (ok) inserer(cache, niveau, m, NULL);
+            else liberer_matrice(m);
+        } else {
+            t_csr *csr = lire_creuse(f, n);
+            ok = (csr != NULL);
+            if (ok) inserer(cache, niveau, NULL, csr);
+        }
+    }
+
+    fclose(f);
+    return ok ? MARKOV_OK : MARKOV_ERR_FORMAT;
+}
+
+// Libère le cache et toutes les puissances gardées
+void liberer_cache_puissances(t_cache_puissances *cache) {
+    if (cache == NULL) return;
+    for (int i = 0; i < CACHE_MAX_NIVEAUX; i++) vider_niveau(&cache->niveaux[i]);
+    free(cache);
+}
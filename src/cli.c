@@ -0,0 +1,468 @@
+#include "cli.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <pthread.h>
+#include "estimation.h"
+
+// Affiche l'utilisation du mode ligne de commande
+void afficher_aide(const char *prog) {
+    printf("Utilisation : %s [options]\n", prog);
+    printf("Sans option, le programme demarre en mode interactif.\n\n");
+    printf("  -i, --entree FICHIER     chaine a analyser (format de data/*.txt)\n");
+    printf("  -d, --dossier DOSSIER    analyse toutes les chaines .txt du dossier\n");
+    printf("  -I, --init FICHIER       distributions initiales (N valeurs par distribution)\n");
+    printf("                           par defaut : distribution uniforme\n");
+    printf("  -n, --puissance N[,N..]  nombre(s) de transitions (defaut 1)\n");
+    printf("  -c, --cache MO           cache des carres de M (budget en Mo), sauvegarde\n");
+    printf("                           dans <chaine>_puissances.bin et reutilise ensuite\n");
+    printf("  -r, --reprise SECONDES   point de reprise de la propagation toutes les SECONDES\n");
+    printf("                           (<chaine>_reprise.bin), repris au lancement suivant\n");
+    printf("  -e, --epsilon EPS        seuil de convergence (defaut 0.01)\n");
+    printf("  -m, --max-iter K|auto    iterations maximales par classe pour la limite (defaut 1000),\n");
+    printf("                           auto : deduit du trou spectral de chaque classe\n");
+    printf("  -s, --etapes LISTE       etapes separees par des virgules parmi :\n");
+    printf("                           verif,mermaid,tarjan,hasse,carac,absorption,\n");
+    printf("                           puissance,convergence,periode,tout (defaut tout)\n");
+    printf("                           et simulation, spectre (hors de tout)\n");
+    printf("  -l, --agreger TOL        regroupe les etats de meme ligne avant les etapes convergence\n");
+    printf("                           et periode (0 : lignes identiques), resultats par etat d'origine\n");
+    printf("  -z, --compresser MODE    graphe compresse pour la partition et la propagation :\n");
+    printf("                           exacte (probabilites float) ou quantifiee (16 bits)\n");
+    printf("  -R, --renumeroter ORDRE  renumerote les etats pour la propagation : classes,\n");
+    printf("                           largeur ou rcm (resultats aux numeros du fichier)\n");
+    printf("  -t, --tolerance TOL      ecart tolere entre 1 et la somme sortante d'un etat (defaut 0.01)\n");
+    printf("  -N, --renormaliser oui|non  divise chaque ligne par sa somme a la lecture (defaut non)\n");
+    printf("  -o, --sortie DOSSIER     dossier des fichiers generes (defaut : celui de la chaine)\n");
+    printf("  -j, --threads T          nombre de chaines traitees en parallele (mode dossier)\n");
+    printf("  -p, --profil FICHIER     temps, memoire et debit de chaque etape en JSON\n");
+    printf("  -f, --format FORMAT      rapport en texte, json ou csv (defaut texte)\n");
+    printf("  -v, --verbosite NIVEAU   silencieux, resume, normal ou detail (defaut normal)\n");
+    printf("  -w, --marches W          simulation : nombre de marches (defaut 100000)\n");
+    printf("  -H, --horizon T          simulation : nombre de pas par marche (defaut 100)\n");
+    printf("  -g, --graine S           simulation : graine (resultat identique quel que soit -j)\n");
+    printf("  -E, --estimer FICHIER    estime une chaine a partir de sequences d'etats\n");
+    printf("                           (une sequence par ligne, \"-\" pour l'entree standard)\n");
+    printf("                           les etats jamais quittes deviennent absorbants (signales)\n");
+    printf("  -C, --chaine FICHIER     chaine estimee (defaut chaine_estimee.txt dans --sortie)\n");
+    printf("  -h, --aide               affiche cette aide\n");
+}
+
+// Traduit une liste "tarjan,hasse,..." en masque d'étapes, 0 si un nom est inconnu
+static unsigned int parser_etapes(const char *liste) {
+    static const struct { const char *nom; unsigned int masque; } noms[] = {
+        {"verif", ETAPE_VERIF}, {"mermaid", ETAPE_MERMAID}, {"tarjan", ETAPE_TARJAN},
+        {"hasse", ETAPE_HASSE}, {"carac", ETAPE_CARAC}, {"absorption", ETAPE_ABSORPTION},
+        {"puissance", ETAPE_PUISSANCE}, {"convergence", ETAPE_CONVERGENCE},
+        {"periode", ETAPE_PERIODE}, {"tout", ETAPE_TOUTES}, {"simulation", ETAPE_SIMULATION},
+        {"spectre", ETAPE_SPECTRE},
+    };
+    unsigned int masque = 0;
+    char copie[256];
+    snprintf(copie, sizeof(copie), "%s", liste);
+
+    for (char *mot = strtok(copie, ","); mot != NULL; mot = strtok(NULL, ",")) {
+        unsigned int trouve = 0;
+        for (size_t k = 0; k < sizeof(noms) / sizeof(noms[0]); k++) {
+            if (strcmp(mot, noms[k].nom) == 0) trouve = noms[k].masque;
+        }
+        if (trouve == 0) {
+            fprintf(stderr, "Etape inconnue : %s\n", mot);
+            return 0;
+        }
+        masque |= trouve;
+    }
+    return masque;
+}
+
+// Traduit un nom de format, -1 s'il est inconnu
+static int parser_format(const char *nom) {
+    if (strcmp(nom, "texte") == 0 || strcmp(nom, "txt") == 0) return FORMAT_TEXTE;
+    if (strcmp(nom, "json") == 0) return FORMAT_JSON;
+    if (strcmp(nom, "csv") == 0) return FORMAT_CSV;
+    return -1;
+}
+
+// Traduit un niveau de verbosité (nom ou chiffre 0 à 3), -1 s'il est inconnu
+static int parser_niveau(const char *nom) {
+    static const char *noms[] = {"silencieux", "resume", "normal", "detail"};
+    for (int k = 0; k < 4; k++) {
+        if (strcmp(nom, noms[k]) == 0) return k;
+    }
+    if (nom[0] >= '0' && nom[0] <= '3' && nom[1] == '\0') return nom[0] - '0';
+    return -1;
+}
+
+// Vrai si l'argument correspond à la forme courte ou longue d'une option
+static int est_option(const char *arg, const char *courte, const char *longue) {
+    return strcmp(arg, courte) == 0 || strcmp(arg, longue) == 0;
+}
+
+//Fonction qui lit les arguments : 0 si on peut lancer l'analyse, 1 si l'aide a été affichée, -1 en cas d'erreur
+int parser_options(int argc, char **argv, t_options *opt) {
+    options_par_defaut(opt);
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+
+        if (est_option(arg, "-h", "--aide")) {
+            afficher_aide(argv[0]);
+            return 1;
+        }
+
+        // Toutes les autres options attendent une valeur
+        if (i + 1 >= argc) {
+            fprintf(stderr, "Option %s : valeur manquante\n", arg);
+            return -1;
+        }
+        const char *val = argv[++i];
+
+        if (est_option(arg, "-i", "--entree")) {
+            opt->entree = val;
+        } else if (est_option(arg, "-d", "--dossier")) {
+            opt->dossier = val;
+        } else if (est_option(arg, "-I", "--init")) {
+            opt->fichier_init = val;
+        } else if (est_option(arg, "-o", "--sortie")) {
+            opt->sortie = val;
+        } else if (est_option(arg, "-n", "--puissance")) {
+            char copie[256];
+            snprintf(copie, sizeof(copie), "%s", val);
+            opt->nb_puissances = 0;
+            for (char *mot = strtok(copie, ","); mot != NULL && opt->nb_puissances < MAX_PUISSANCES; mot = strtok(NULL, ",")) {
+                int n = atoi(mot);
+                if (n < 0) {
+                    fprintf(stderr, "Puissance invalide : %s\n", mot);
+                    return -1;
+                }
+                // Chaque horizon donne une section distributions_<n> : un horizon répété la dupliquerait
+                for (int k = 0; k < opt->nb_puissances; k++) {
+                    if (opt->puissances[k] == n) {
+                        fprintf(stderr, "Puissance repetee : %d\n", n);
+                        return -1;
+                    }
+                }
+                opt->puissances[opt->nb_puissances++] = n;
+            }
+            if (opt->nb_puissances == 0) {
+                fprintf(stderr, "Puissance manquante\n");
+                return -1;
+            }
+        } else if (est_option(arg, "-c", "--cache")) {
+            opt->cache_mo = atoll(val);
+        } else if (est_option(arg, "-r", "--reprise")) {
+            opt->reprise = atof(val);
+            if (opt->reprise < 0.0) {
+                fprintf(stderr, "Intervalle de reprise invalide : %s\n", val);
+                return -1;
+            }
+        } else if (est_option(arg, "-l", "--agreger")) {
+            opt->agregation = atof(val);
+            if (opt->agregation < 0.0) {
+                fprintf(stderr, "Tolerance d'agregation invalide : %s\n", val);
+                return -1;
+            }
+        } else if (est_option(arg, "-z", "--compresser")) {
+            if (strcmp(val, "exacte") == 0) opt->compression = COMPRESSION_EXACTE;
+            else if (strcmp(val, "quantifiee") == 0) opt->compression = COMPRESSION_QUANTIFIEE;
+            else {
+                fprintf(stderr, "Mode de compression inconnu : %s\n", val);
+                return -1;
+            }
+        } else if (est_option(arg, "-R", "--renumeroter")) {
+            int ordre = ordre_depuis_nom(val);
+            if (ordre < 0) {
+                fprintf(stderr, "Ordre de renumerotation inconnu : %s\n", val);
+                return -1;
+            }
+            opt->ordre = ordre;
+        } else if (est_option(arg, "-t", "--tolerance")) {
+            opt->tolerance = atof(val);
+            if (opt->tolerance < 0.0) {
+                fprintf(stderr, "Tolerance invalide : %s\n", val);
+                return -1;
+            }
+        } else if (est_option(arg, "-N", "--renormaliser")) {
+            if (strcmp(val, "oui") == 0) opt->renormaliser = 1;
+            else if (strcmp(val, "non") == 0) opt->renormaliser = 0;
+            else {
+                fprintf(stderr, "Valeur de --renormaliser inconnue : %s\n", val);
+                return -1;
+            }
+        } else if (est_option(arg, "-e", "--epsilon")) {
+            opt->epsilon = atof(val);
+        } else if (est_option(arg, "-m", "--max-iter")) {
+            opt->max_iter = (strcmp(val, "auto") == 0) ? 0 : atoi(val);
+            if (opt->max_iter < 1 && strcmp(val, "auto") != 0) {
+                fprintf(stderr, "Nombre d'iterations invalide : %s\n", val);
+                return -1;
+            }
+        } else if (est_option(arg, "-p", "--profil") || strcmp(arg, "--profile") == 0) {
+            opt->profil = val;
+        } else if (est_option(arg, "-w", "--marches")) {
+            opt->nb_marches = atoll(val);
+        } else if (est_option(arg, "-H", "--horizon")) {
+            opt->horizon = atoi(val);
+        } else if (est_option(arg, "-g", "--graine")) {
+            opt->graine = strtoull(val, NULL, 10);
+        } else if (est_option(arg, "-f", "--format")) {
+            int format = parser_format(val);
+            if (format < 0) {
+                fprintf(stderr, "Format inconnu : %s\n", val);
+                return -1;
+            }
+            opt->format = format;
+        } else if (est_option(arg, "-v", "--verbosite")) {
+            int niveau = parser_niveau(val);
+            if (niveau < 0) {
+                fprintf(stderr, "Niveau de verbosite inconnu : %s\n", val);
+                return -1;
+            }
+            opt->niveau = niveau;
+        } else if (est_option(arg, "-E", "--estimer")) {
+            opt->sequences = val;
+        } else if (est_option(arg, "-C", "--chaine")) {
+            opt->chaine_estimee = val;
+        } else if (est_option(arg, "-j", "--threads")) {
+            opt->nb_threads = atoi(val);
+        } else if (est_option(arg, "-s", "--etapes")) {
+            opt->etapes = parser_etapes(val);
+            if (opt->etapes == 0) return -1;
+        } else {
+            fprintf(stderr, "Option inconnue : %s\n", arg);
+            return -1;
+        }
+    }
+
+    if ((opt->entree != NULL) + (opt->dossier != NULL) + (opt->sequences != NULL) != 1) {
+        fprintf(stderr, "Indiquez soit --entree, soit --dossier, soit --estimer\n");
+        return -1;
+    }
+    if (opt->cache_mo < 0 || opt->epsilon <= 0.0 || opt->max_iter < 0 || opt->nb_marches < 1 || opt->horizon < 0) {
+        fprintf(stderr, "Parametres numeriques invalides\n");
+        return -1;
+    }
+    if (opt->nb_threads < 1) opt->nb_threads = 1;
+    return 0;
+}
+
+/** File de travail partagée par les threads du mode dossier:
+- Chemins des chaînes à traiter
+- Indice de la prochaine chaîne libre (protégé par le verrou)
+- Code de retour et profil de chaque chaîne
+- Nombre de threads lancés (plus d'un : profils sans mesures de mémoire)
+**/
+typedef struct {
+    char **chemins;
+    int nb;
+    int suivant;
+    int *codes;
+    t_profil *profils;
+    int nb_threads;
+    const t_options *opt;
+    pthread_mutex_t verrou;
+} t_file_travail;
+
+// Boucle d'un thread : prend la prochaine chaîne jusqu'à épuisement
+static void* travailleur(void *arg) {
+    static const char *extensions[] = {"txt", "json", "csv"};
+    t_file_travail *file = arg;
+
+    while (1) {
+        pthread_mutex_lock(&file->verrou);
+        int k = file->suivant++;
+        pthread_mutex_unlock(&file->verrou);
+        if (k >= file->nb) break;
+
+        // Chaque chaîne a son propre rapport : les threads n'écrivent jamais dans le même fichier
+        const char *chemin = file->chemins[k];
+        const char *extension = extensions[file->opt->format];
+        char rapport_nom[800];
+        const char *base = strrchr(chemin, '/');
+        base = (base != NULL) ? base + 1 : chemin;
+        if (file->opt->sortie != NULL) {
+            snprintf(rapport_nom, sizeof(rapport_nom), "%s/%.*s_rapport.%s", file->opt->sortie,
+                     (int)(strlen(base) - 4), base, extension);
+        } else {
+            snprintf(rapport_nom, sizeof(rapport_nom), "%.*s_rapport.%s", (int)(strlen(chemin) - 4), chemin, extension);
+        }
+
+        t_profil *profil = NULL;
+        if (file->profils != NULL) {
+            profil = &file->profils[k];
+            profil_init(profil, chemin);
+            profil->concurrent = (file->nb_threads > 1);
+        }
+
+        FILE *rapport = fopen(rapport_nom, "w");
+        if (rapport == NULL) {
+            file->codes[k] = 1;
+            continue;
+        }
+        t_sortie *sortie = creer_sortie(rapport, file->opt->format, file->opt->niveau);
+        file->codes[k] = analyser_chaine(chemin, file->opt, sortie, profil);
+        liberer_sortie(sortie);
+        fclose(rapport);
+    }
+    return NULL;
+}
+
+// Vrai pour un fichier de chaîne (.txt) qui n'est pas un fichier généré par le programme
+static int est_fichier_chaine(const char *nom) {
+    size_t len = strlen(nom);
+    if (len < 5 || strcmp(nom + len - 4, ".txt") != 0) return 0;
+    return strstr(nom, "_mermaid") == NULL && strstr(nom, "_hasse") == NULL && strstr(nom, "_rapport") == NULL;
+}
+
+static int comparer_chemins(const void *a, const void *b) {
+    return strcmp(*(char * const *)a, *(char * const *)b);
+}
+
+//Fonction qui analyse toutes les chaînes d'un dossier sur un pool de threads
+int traiter_dossier(const t_options *opt) {
+    DIR *dir = opendir(opt->dossier);
+    if (dir == NULL) {
+        fprintf(stderr, "Erreur : Impossible d'ouvrir le repertoire %s\n", opt->dossier);
+        return 1;
+    }
+
+    t_file_travail file;
+    int capacite = 16;
+    file.chemins = malloc(capacite * sizeof(char*));
+    file.nb = 0;
+
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (!est_fichier_chaine(entry->d_name)) continue;
+        if (file.nb >= capacite) {
+            capacite *= 2;
+            file.chemins = realloc(file.chemins, capacite * sizeof(char*));
+        }
+        size_t taille = strlen(opt->dossier) + strlen(entry->d_name) + 2;
+        file.chemins[file.nb] = malloc(taille);
+        snprintf(file.chemins[file.nb], taille, "%s/%s", opt->dossier, entry->d_name);
+        file.nb++;
+    }
+    closedir(dir);
+
+    // Ordre stable pour le récapitulatif
+    qsort(file.chemins, file.nb, sizeof(char*), comparer_chemins);
+
+    file.suivant = 0;
+    file.codes = calloc(file.nb > 0 ? file.nb : 1, sizeof(int));
+    file.opt = opt;
+    file.profils = (opt->profil != NULL) ? calloc(file.nb > 0 ? file.nb : 1, sizeof(t_profil)) : NULL;
+    pthread_mutex_init(&file.verrou, NULL);
+
+    int nb_threads = (opt->nb_threads < file.nb) ? opt->nb_threads : file.nb;
+    file.nb_threads = nb_threads;
+    pthread_t *threads = malloc((nb_threads > 0 ? nb_threads : 1) * sizeof(pthread_t));
+    for (int t = 0; t < nb_threads; t++) {
+        pthread_create(&threads[t], NULL, travailleur, &file);
+    }
+    for (int t = 0; t < nb_threads; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+    // Récapitulatif
+    int nb_erreurs = 0;
+    printf("\n%d chaine(s) traitee(s) avec %d thread(s) :\n", file.nb, nb_threads);
+    for (int k = 0; k < file.nb; k++) {
+        printf("  %s : %s\n", file.chemins[k], file.codes[k] == 0 ? "ok" : "ERREUR");
+        if (file.codes[k] != 0) nb_erreurs++;
+        free(file.chemins[k]);
+    }
+
+    if (file.profils != NULL) {
+        if (profil_sauvegarder_json(file.profils, file.nb, opt->profil) != 0) {
+            fprintf(stderr, "Erreur : impossible d'ecrire le profil %s\n", opt->profil);
+        }
+        free(file.profils);
+    }
+
+    pthread_mutex_destroy(&file.verrou);
+    free(threads);
+    free(file.codes);
+    free(file.chemins);
+    return nb_erreurs > 0 ? 1 : 0;
+}
+
+//Fonction qui estime une chaîne à partir de séquences d'états et l'écrit au format de data/*.txt
+int estimer_chaine(const t_options *opt) {
+    int depuis_stdin = (strcmp(opt->sequences, "-") == 0);
+    FILE *flux = depuis_stdin ? stdin : fopen(opt->sequences, "r");
+    if (flux == NULL) {
+        fprintf(stderr, "Erreur : impossible d'ouvrir les sequences %s\n", opt->sequences);
+        return 1;
+    }
+
+    t_estimateur *est = creer_estimateur();
+    int code = estimer_flux(est, flux, opt->nb_threads);
+    if (!depuis_stdin) fclose(flux);
+    if (code != 0) {
+        fprintf(stderr, "Erreur de lecture des sequences %s\n", opt->sequences);
+        liberer_estimateur(est);
+        return 1;
+    }
+
+    printf("%llu etats observes, %llu transitions, %d sommets", est->nb_observations, est->nb_transitions, est->nb_sommets);
+    if (est->nb_invalides > 0) printf(", %llu valeurs invalides ignorees", est->nb_invalides);
+    printf("\n");
+    if (est->nb_sommets == 0) {
+        fprintf(stderr, "Erreur : aucune sequence valide\n");
+        liberer_estimateur(est);
+        return 1;
+    }
+
+    char fichier[800];
+    if (opt->sortie != NULL && strchr(opt->chaine_estimee, '/') == NULL) {
+        snprintf(fichier, sizeof(fichier), "%s/%s", opt->sortie, opt->chaine_estimee);
+    } else {
+        snprintf(fichier, sizeof(fichier), "%s", opt->chaine_estimee);
+    }
+
+    int nb_absorbants, nb_absents;
+    listeAdj g = estimateur_vers_chaine(est, &nb_absorbants, &nb_absents);
+    liberer_estimateur(est);
+    if (nb_absorbants > 0) {
+        printf("Attention : %d etats jamais quittes rendus absorbants (boucle de probabilite 1)", nb_absorbants);
+        if (nb_absents > 0) printf(", dont %d numeros absents des sequences", nb_absents);
+        printf("\n");
+    }
+    code = ecrireGraphe(g, fichier);
+    liberer_listeAdj(&g);
+    if (code != 0) {
+        fprintf(stderr, "Erreur : impossible d'ecrire %s\n", fichier);
+        return 1;
+    }
+    printf("Chaine estimee : %s\n", fichier);
+    return 0;
+}
+
+//Fonction principale du mode ligne de commande
+int executer_cli(const t_options *opt) {
+    if (opt->sequences != NULL) {
+        return estimer_chaine(opt);
+    }
+    if (opt->dossier != NULL) {
+        return traiter_dossier(opt);
+    }
+
+    t_sortie *sortie = creer_sortie(stdout, opt->format, opt->niveau);
+    if (opt->profil == NULL) {
+        int code = analyser_chaine(opt->entree, opt, sortie, NULL);
+        liberer_sortie(sortie);
+        return code;
+    }
+
+    t_profil profil;
+    profil_init(&profil, opt->entree);
+    int code = analyser_chaine(opt->entree, opt, sortie, &profil);
+    liberer_sortie(sortie);
+    if (profil_sauvegarder_json(&profil, 1, opt->profil) != 0) {
+        fprintf(stderr, "Erreur : impossible d'ecrire le profil %s\n", opt->profil);
+        code = 1;
+    }
+    return code;
+}
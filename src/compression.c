@@ -0,0 +1,388 @@
+#include "compression.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// Taille maximale d'une arête codée : varint 32 bits (5 octets) et probabilité float (4 octets)
+#define OCTETS_MAX_ARETE 9
+
+// Arête d'une ligne en cours de compression
+typedef struct {
+    int rang;
+    int arrivee;
+    double proba;
+    double reste;
+    unsigned int quantum;
+} t_arete_brute;
+
+// Lecture d'une ligne codée, arête par arête
+typedef struct {
+    const unsigned char *pos;
+    const unsigned char *fin;
+    int arrivee;
+    t_mode_compression mode;
+} t_curseur;
+
+static int comparer_rangs(const void *a, const void *b) {
+    const t_arete_brute *x = a, *y = b;
+    return (x->rang > y->rang) - (x->rang < y->rang);
+}
+
+// Restes décroissants, à égalité la première arête de la liste d'abord (résultat reproductible)
+static int comparer_restes(const void *a, const void *b) {
+    const t_arete_brute *x = a, *y = b;
+    if (x->reste != y->reste) return (x->reste < y->reste) - (x->reste > y->reste);
+    return comparer_rangs(a, b);
+}
+
+static unsigned char* ecrire_varint(unsigned char *p, unsigned int v) {
+    while (v >= 0x80) {
+        *p++ = (unsigned char)(v | 0x80);
+        v >>= 7;
+    }
+    *p++ = (unsigned char)v;
+    return p;
+}
+
+// Décodage déroulé : un test par octet, sans boucle (au plus 5 octets pour 32 bits)
+static inline const unsigned char* lire_varint(const unsigned char *p, unsigned int *v) {
+    unsigned int x = p[0];
+    if (x < 0x80) { *v = x; return p + 1; }
+    x = (x & 0x7F) | (unsigned int)p[1] << 7;
+    if (p[1] < 0x80) { *v = x; return p + 2; }
+    x = (x & 0x3FFF) | (unsigned int)p[2] << 14;
+    if (p[2] < 0x80) { *v = x; return p + 3; }
+    x = (x & 0x1FFFFF) | (unsigned int)p[3] << 21;
+    if (p[3] < 0x80) { *v = x; return p + 4; }
+    *v = (x & 0xFFFFFFF) | (unsigned int)p[4] << 28;
+    return p + 5;
+}
+
+// Écart signé vers entier non signé : les petits écarts, positifs ou négatifs, restent petits
+static unsigned int zigzag(int d) {
+    return (d < 0) ? ((unsigned int)(-(long long)d) << 1) - 1 : (unsigned int)d << 1;
+}
+
+static inline int dezigzag(unsigned int v) {
+    return (v & 1) ? -(int)(v >> 1) - 1 : (int)(v >> 1);
+}
+
+// Quanta d'une ligne : arrondis par défaut, puis les restes les plus grands (ou les plus petits)
+// reçoivent (ou perdent) une unité jusqu'à retrouver l'arrondi de la somme d'origine.
+// Une arête de probabilité non nulle garde au moins un quantum : le graphe ne change pas.
+static void quantifier_ligne(t_arete_brute *aretes, int deg) {
+    double somme = 0.0;
+    long long total = 0;
+    for (int k = 0; k < deg; k++) {
+        double p = (aretes[k].proba > 0.0) ? aretes[k].proba : 0.0;
+        double exact = p * ECHELLE_QUANTUM;
+        if (exact > ECHELLE_QUANTUM) exact = ECHELLE_QUANTUM;
+        aretes[k].quantum = (unsigned int)exact;
+        if (p > 0.0 && aretes[k].quantum == 0) aretes[k].quantum = 1;
+        aretes[k].reste = exact - aretes[k].quantum;
+        somme += p;
+        total += aretes[k].quantum;
+    }
+    long long ecart = llround(somme * ECHELLE_QUANTUM) - total;
+    if (ecart == 0) return;
+
+    qsort(aretes, deg, sizeof(t_arete_brute), comparer_restes);
+    int progres = 1;
+    while (ecart > 0 && progres) {
+        progres = 0;
+        for (int k = 0; k < deg && ecart > 0; k++) {
+            if (aretes[k].proba <= 0.0 || aretes[k].quantum >= ECHELLE_QUANTUM) continue;
+            aretes[k].quantum++;
+            ecart--;
+            progres = 1;
+        }
+    }
+    while (ecart < 0 && progres) {
+        progres = 0;
+        for (int k = deg - 1; k >= 0 && ecart < 0; k--) {
+            if (aretes[k].quantum <= 1) continue;
+            aretes[k].quantum--;
+            ecart++;
+            progres = 1;
+        }
+    }
+    qsort(aretes, deg, sizeof(t_arete_brute), comparer_rangs);
+}
+
+//Fonction qui compresse la liste d'adjacence (NULL si le mode est inconnu ou la mémoire manque)
+t_graphe_compresse* compresser_graphe(listeAdj *g, t_mode_compression mode) {
+    if (mode != COMPRESSION_EXACTE && mode != COMPRESSION_QUANTIFIEE) return NULL;
+
+    int n = g->nb_sommets;
+    t_graphe_compresse *gc = malloc(sizeof(t_graphe_compresse));
+    gc->nb_sommets = n;
+    gc->nb_aretes = 0;
+    gc->mode = mode;
+    gc->debut = malloc(((size_t)n + 1) * sizeof(size_t));
+    size_t capacite = 1024;
+    gc->octets = malloc(capacite);
+    gc->taille = 0;
+
+    int capacite_ligne = 16;
+    t_arete_brute *aretes = malloc(capacite_ligne * sizeof(t_arete_brute));
+
+    for (int i = 0; i < n; i++) {
+        gc->debut[i] = gc->taille;
+
+        int deg = 0;
+        for (cell *c = g->tab_liste[i].head; c != NULL; c = c->suivante) {
+            if (deg >= capacite_ligne) {
+                capacite_ligne *= 2;
+                aretes = realloc(aretes, capacite_ligne * sizeof(t_arete_brute));
+            }
+            aretes[deg].rang = deg;
+            aretes[deg].arrivee = c->sommet_arrivee - 1;
+            aretes[deg].proba = c->proba;
+            deg++;
+        }
+        if (deg == 0) continue;
+        if (mode == COMPRESSION_QUANTIFIEE) quantifier_ligne(aretes, deg);
+
+        if (gc->taille + (size_t)deg * OCTETS_MAX_ARETE > capacite) {
+            while (gc->taille + (size_t)deg * OCTETS_MAX_ARETE > capacite) capacite *= 2;
+            unsigned char *octets = realloc(gc->octets, capacite);
+            if (octets == NULL) {
+                free(aretes);
+                liberer_graphe_compresse(gc);
+                return NULL;
+            }
+            gc->octets = octets;
+        }
+
+        unsigned char *p = gc->octets + gc->taille;
+        int precedente = i;
+        for (int k = 0; k < deg; k++) {
+            p = ecrire_varint(p, zigzag(aretes[k].arrivee - precedente));
+            precedente = aretes[k].arrivee;
+            if (mode == COMPRESSION_QUANTIFIEE) {
+                *p++ = (unsigned char)(aretes[k].quantum & 0xFF);
+                *p++ = (unsigned char)(aretes[k].quantum >> 8);
+            } else {
+                float proba = (float)aretes[k].proba;
+                memcpy(p, &proba, sizeof(float));
+                p += sizeof(float);
+            }
+        }
+        gc->taille = (size_t)(p - gc->octets);
+        gc->nb_aretes += deg;
+    }
+    gc->debut[n] = gc->taille;
+    free(aretes);
+
+    // Le flux est rendu à sa taille exacte
+    if (gc->taille > 0) {
+        unsigned char *octets = realloc(gc->octets, gc->taille);
+        if (octets != NULL) gc->octets = octets;
+    }
+    return gc;
+}
+
+// Libère la mémoire du graphe compressé
+void liberer_graphe_compresse(t_graphe_compresse *gc) {
+    if (gc == NULL) return;
+    free(gc->debut);
+    free(gc->octets);
+    free(gc);
+}
+
+// Mémoire occupée par le graphe compressé (structure, index des lignes et flux)
+size_t compresse_octets(const t_graphe_compresse *gc) {
+    return sizeof(t_graphe_compresse) + ((size_t)gc->nb_sommets + 1) * sizeof(size_t) + gc->taille;
+}
+
+static inline void curseur_ligne(const t_graphe_compresse *gc, int i, t_curseur *c) {
+    c->pos = gc->octets + gc->debut[i];
+    c->fin = gc->octets + gc->debut[i + 1];
+    c->arrivee = i;
+    c->mode = gc->mode;
+}
+
+// Arrivée suivante de la ligne (0 en fin de ligne) ; la probabilité est sautée
+static inline int curseur_arrivee(t_curseur *c, int *j) {
+    if (c->pos >= c->fin) return 0;
+    unsigned int v;
+    c->pos = lire_varint(c->pos, &v);
+    c->arrivee += dezigzag(v);
+    c->pos += (c->mode == COMPRESSION_QUANTIFIEE) ? 2 : sizeof(float);
+    *j = c->arrivee;
+    return 1;
+}
+
+// Arête suivante de la ligne avec sa probabilité décodée (0 en fin de ligne)
+static inline int curseur_arete(t_curseur *c, int *j, double *proba) {
+    if (c->pos >= c->fin) return 0;
+    unsigned int v;
+    c->pos = lire_varint(c->pos, &v);
+    c->arrivee += dezigzag(v);
+    if (c->mode == COMPRESSION_QUANTIFIEE) {
+        unsigned int q = c->pos[0] | (unsigned int)c->pos[1] << 8;
+        *proba = q * (1.0 / ECHELLE_QUANTUM);
+        c->pos += 2;
+    } else {
+        float p;
+        memcpy(&p, c->pos, sizeof(float));
+        *proba = p;
+        c->pos += sizeof(float);
+    }
+    *j = c->arrivee;
+    return 1;
+}
+
+//Fonction qui décode la ligne du sommet i+1 et renvoie son degré (tableaux NULL : degré seul)
+int compresse_ligne(const t_graphe_compresse *gc, int i, int *arrivees, double *probas) {
+    t_curseur c;
+    curseur_ligne(gc, i, &c);
+    int deg = 0, j;
+    double p;
+    while (curseur_arete(&c, &j, &p)) {
+        if (arrivees != NULL) arrivees[deg] = j;
+        if (probas != NULL) probas[deg] = p;
+        deg++;
+    }
+    return deg;
+}
+
+// Produit vecteur ligne x matrice : y = x * P (y est écrasé), décodé au fil du parcours
+void compresse_propager_vecteur(const t_graphe_compresse *gc, const double *x, double *y) {
+    memset(y, 0, gc->nb_sommets * sizeof(double));
+    for (int i = 0; i < gc->nb_sommets; i++) {
+        double xi = x[i];
+        if (xi == 0.0) continue;
+        t_curseur c;
+        curseur_ligne(gc, i, &c);
+        int j;
+        double p;
+        while (curseur_arete(&c, &j, &p)) y[j] += xi * p;
+    }
+}
+
+// Lignes du flux propagées sur le bloc ; quantifie est constant à chaque appel, le compilateur
+// produit donc une boucle par mode sans test par arête
+static inline void propager_flux(const t_graphe_compresse *gc, const double *restrict X, double *restrict Y,
+                                 int K, const int quantifie) {
+    const unsigned char *p = gc->octets;
+    for (int i = 0; i < gc->nb_sommets; i++) {
+        const unsigned char *fin = gc->octets + gc->debut[i + 1];
+        const double *restrict xi = X + (size_t)i * K;
+        int j = i;
+        while (p < fin) {
+            unsigned int v;
+            p = lire_varint(p, &v);
+            j += dezigzag(v);
+            double proba;
+            if (quantifie) {
+                proba = (p[0] | (unsigned int)p[1] << 8) * (1.0 / ECHELLE_QUANTUM);
+                p += 2;
+            } else {
+                float f;
+                memcpy(&f, p, sizeof(float));
+                proba = f;
+                p += sizeof(float);
+            }
+
+            double *restrict yj = Y + (size_t)j * K;
+            if (K == 1) {
+                yj[0] += proba * xi[0];
+            } else {
+                for (int k = 0; k < K; k++) {
+                    yj[k] += proba * xi[k];
+                }
+            }
+        }
+    }
+}
+
+// Un pas de propagation sur le bloc N x K (rangé sommet par sommet) : Y = X * P.
+// Le flux est lu d'un seul trait, dans l'ordre des lignes
+void compresse_propager_etape(const t_graphe_compresse *gc, const double *restrict X, double *restrict Y, int K) {
+    memset(Y, 0, (size_t)gc->nb_sommets * K * sizeof(double));
+    if (gc->mode == COMPRESSION_QUANTIFIEE) propager_flux(gc, X, Y, K, 1);
+    else propager_flux(gc, X, Y, K, 0);
+}
+
+// Appel en cours du parcours en profondeur : sommet et position dans sa ligne
+typedef struct {
+    int sommet;
+    t_curseur curseur;
+} t_appel;
+
+//Fonction qui calcule les classes (Tarjan) sur le graphe compressé. Le parcours est itératif
+//(pas de récursion dont la profondeur suit la taille du graphe) et ne décode que les arrivées.
+//Les successeurs sont visités dans l'ordre des listes : même partition que tarjan_calculer_partition.
+t_partition* compresse_partition(const t_graphe_compresse *gc) {
+    int n = gc->nb_sommets;
+    int *num = malloc((n > 0 ? n : 1) * sizeof(int));
+    int *bas = malloc((n > 0 ? n : 1) * sizeof(int));
+    char *dans_pile = calloc(n > 0 ? n : 1, sizeof(char));
+    int *pile = malloc((n > 0 ? n : 1) * sizeof(int));
+    int *composante = malloc((n > 0 ? n : 1) * sizeof(int));
+    t_appel *appels = malloc((n > 0 ? n : 1) * sizeof(t_appel));
+    for (int i = 0; i < n; i++) num[i] = -1;
+
+    t_partition *partition = malloc(sizeof(t_partition));
+    partition->capacite = (n > 0) ? n : 1;
+    partition->classes = malloc(partition->capacite * sizeof(t_classe));
+    partition->taille = 0;
+
+    int compteur = 0, taille_pile = 0;
+    for (int s = 0; s < n; s++) {
+        if (num[s] != -1) continue;
+
+        int profondeur = 0;
+        num[s] = bas[s] = compteur++;
+        pile[taille_pile++] = s;
+        dans_pile[s] = 1;
+        appels[profondeur].sommet = s;
+        curseur_ligne(gc, s, &appels[profondeur].curseur);
+        profondeur++;
+
+        while (profondeur > 0) {
+            t_appel *appel = &appels[profondeur - 1];
+            int v = appel->sommet, j;
+
+            if (curseur_arrivee(&appel->curseur, &j)) {
+                if (num[j] == -1) {
+                    num[j] = bas[j] = compteur++;
+                    pile[taille_pile++] = j;
+                    dans_pile[j] = 1;
+                    appels[profondeur].sommet = j;
+                    curseur_ligne(gc, j, &appels[profondeur].curseur);
+                    profondeur++;
+                } else if (dans_pile[j] && num[j] < bas[v]) {
+                    bas[v] = num[j];
+                }
+                continue;
+            }
+
+            // Ligne épuisée : fin de l'appel sur v
+            profondeur--;
+            if (bas[v] == num[v]) {
+                int taille = 0, w;
+                do {
+                    w = pile[--taille_pile];
+                    dans_pile[w] = 0;
+                    composante[taille++] = w + 1;
+                } while (w != v);
+                ajouter_classe(partition, composante, taille);
+            }
+            if (profondeur > 0) {
+                int u = appels[profondeur - 1].sommet;
+                if (bas[v] < bas[u]) bas[u] = bas[v];
+            }
+        }
+    }
+
+    free(num);
+    free(bas);
+    free(dans_pile);
+    free(pile);
+    free(composante);
+    free(appels);
+    return partition;
+}
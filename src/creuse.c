@@ -0,0 +1,72 @@
+#include "creuse.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "alea.h"
+
+//Fonction qui construit la matrice creuse (CSR) à partir de la liste d'adjacence
+t_csr* creer_csr(listeAdj *g) {
+    int n = g->nb_sommets;
+    t_csr *csr = malloc(sizeof(t_csr));
+    csr->nb_sommets = n;
+    csr->debut = malloc((n + 1) * sizeof(int));
+
+    // Premier passage : nombre d'arêtes de chaque sommet
+    csr->debut[0] = 0;
+    for (int i = 0; i < n; i++) {
+        int deg = 0;
+        for (cell *c = g->tab_liste[i].head; c != NULL; c = c->suivante) deg++;
+        csr->debut[i + 1] = csr->debut[i] + deg;
+    }
+    csr->nb_aretes = csr->debut[n];
+
+    csr->arrivee = malloc((csr->nb_aretes > 0 ? csr->nb_aretes : 1) * sizeof(int));
+    csr->proba = malloc((csr->nb_aretes > 0 ? csr->nb_aretes : 1) * sizeof(double));
+
+    // Second passage : copie des arêtes dans l'ordre des listes
+    for (int i = 0; i < n; i++) {
+        int e = csr->debut[i];
+        for (cell *c = g->tab_liste[i].head; c != NULL; c = c->suivante) {
+            csr->arrivee[e] = c->sommet_arrivee - 1;
+            csr->proba[e] = c->proba;
+            e++;
+        }
+    }
+
+    return csr;
+}
+
+// Libère la mémoire de la matrice creuse
+void liberer_csr(t_csr *csr) {
+    if (csr == NULL) return;
+    free(csr->debut);
+    free(csr->arrivee);
+    free(csr->proba);
+    free(csr);
+}
+
+// Produit vecteur ligne x matrice : y = x * P (y est écrasé)
+void csr_propager_vecteur(const t_csr *csr, const double *x, double *y) {
+    memset(y, 0, csr->nb_sommets * sizeof(double));
+    for (int i = 0; i < csr->nb_sommets; i++) {
+        double xi = x[i];
+        if (xi == 0.0) continue;
+        for (int e = csr->debut[i]; e < csr->debut[i + 1]; e++) {
+            y[csr->arrivee[e]] += xi * csr->proba[e];
+        }
+    }
+}
+
+// Signature de la chaîne : change dès qu'une arête ou une probabilité change
+unsigned long long csr_signature(const t_csr *csr) {
+    unsigned long long h = alea_melanger((unsigned long long)csr->nb_sommets);
+    for (int i = 0; i < csr->nb_sommets; i++) {
+        for (int e = csr->debut[i]; e < csr->debut[i + 1]; e++) {
+            unsigned long long bits;
+            memcpy(&bits, &csr->proba[e], sizeof(bits));
+            h = alea_melanger(h ^ ((unsigned long long)i << 32 | (unsigned int)csr->arrivee[e]));
+            h = alea_melanger(h ^ bits);
+        }
+    }
+    return h;
+}
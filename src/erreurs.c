@@ -0,0 +1,14 @@
+#include "erreurs.h"
+
+// Message associé à un code de retour (chaîne statique, utilisable depuis plusieurs threads)
+const char* markov_message_erreur(int code) {
+    switch (code) {
+        case MARKOV_OK: return "succes";
+        case MARKOV_ERR_FICHIER: return "fichier introuvable ou illisible";
+        case MARKOV_ERR_FORMAT: return "format de fichier invalide";
+        case MARKOV_ERR_MEMOIRE: return "memoire insuffisante";
+        case MARKOV_ERR_DIMENSIONS: return "dimensions incompatibles";
+        case MARKOV_ERR_PARAMETRE: return "parametre invalide";
+        default: return "erreur inconnue";
+    }
+}
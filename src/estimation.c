@@ -0,0 +1,306 @@
+#include "estimation.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "alea.h"
+
+/* Estimation d'une chaîne par comptage des transitions observées.
+ * Le flux contient une séquence d'identifiants d'états (1 à N) par ligne,
+ * séparés par des espaces, tabulations, virgules ou points-virgules : une
+ * transition est comptée entre deux états consécutifs d'une même ligne.
+ * Les threads lisent le flux par blocs de lignes entières, cumulent leurs
+ * comptes dans un petit cache local et ne touchent la table partagée que
+ * lorsqu'une case du cache est remplacée.
+ */
+
+// Taille d'un bloc lu par un thread (complété jusqu'à la fin de ligne)
+#define TAILLE_BLOC (1 << 20)
+// Nombre de cases du cache local d'un thread (puissance de 2)
+#define TAILLE_CACHE 4096
+#define CAPACITE_FRAGMENT_INITIALE 1024
+
+// Case du cache local : transition et nombre d'observations pas encore reportées
+typedef struct {
+    unsigned long long cle;
+    unsigned long long compte;
+} t_case_cache;
+
+// Flux partagé par les threads (lecture protégée par le verrou)
+typedef struct {
+    t_estimateur *est;
+    FILE *flux;
+    pthread_mutex_t verrou;
+} t_lecture;
+
+static unsigned long long creer_cle(int depart, int arrivee) {
+    return ((unsigned long long)depart << 32) | (unsigned int)arrivee;
+}
+
+// Agrandit un fragment (appelé avec son verrou pris)
+static void agrandir_fragment(t_fragment *f) {
+    size_t ancienne = f->capacite;
+    unsigned long long *cles = f->cles;
+    unsigned long long *comptes = f->comptes;
+
+    f->capacite = ancienne * 2;
+    f->cles = calloc(f->capacite, sizeof(unsigned long long));
+    f->comptes = calloc(f->capacite, sizeof(unsigned long long));
+    for (size_t k = 0; k < ancienne; k++) {
+        if (cles[k] == 0) continue;
+        size_t pos = alea_melanger(cles[k]) & (f->capacite - 1);
+        while (f->cles[pos] != 0) pos = (pos + 1) & (f->capacite - 1);
+        f->cles[pos] = cles[k];
+        f->comptes[pos] = comptes[k];
+    }
+    free(cles);
+    free(comptes);
+}
+
+// Ajoute nb observations d'une transition (clé non nulle) dans la table partagée
+static void ajouter_cle(t_estimateur *est, unsigned long long cle, unsigned long long nb) {
+    unsigned long long h = alea_melanger(cle);
+    t_fragment *f = &est->fragments[h >> 58];
+
+    pthread_mutex_lock(&f->verrou);
+    if (2 * (f->nb + 1) > f->capacite) agrandir_fragment(f);
+    size_t pos = h & (f->capacite - 1);
+    while (f->cles[pos] != 0 && f->cles[pos] != cle) pos = (pos + 1) & (f->capacite - 1);
+    if (f->cles[pos] == 0) {
+        f->cles[pos] = cle;
+        f->nb++;
+    }
+    f->comptes[pos] += nb;
+    pthread_mutex_unlock(&f->verrou);
+}
+
+// Crée un estimateur vide
+t_estimateur* creer_estimateur(void) {
+    t_estimateur *est = calloc(1, sizeof(t_estimateur));
+    for (int i = 0; i < NB_FRAGMENTS; i++) {
+        est->fragments[i].capacite = CAPACITE_FRAGMENT_INITIALE;
+        est->fragments[i].cles = calloc(CAPACITE_FRAGMENT_INITIALE, sizeof(unsigned long long));
+        est->fragments[i].comptes = calloc(CAPACITE_FRAGMENT_INITIALE, sizeof(unsigned long long));
+        pthread_mutex_init(&est->fragments[i].verrou, NULL);
+    }
+    pthread_mutex_init(&est->verrou, NULL);
+    return est;
+}
+
+//Fonction qui compte nb observations de la transition depart -> arrivee (sommets 1 à N), utilisable depuis plusieurs threads
+void estimateur_ajouter(t_estimateur *est, int depart, int arrivee, unsigned long long nb) {
+    if (depart < 1 || arrivee < 1) return;
+    ajouter_cle(est, creer_cle(depart, arrivee), nb);
+
+    pthread_mutex_lock(&est->verrou);
+    if (depart > est->nb_sommets) est->nb_sommets = depart;
+    if (arrivee > est->nb_sommets) est->nb_sommets = arrivee;
+    est->nb_transitions += nb;
+    pthread_mutex_unlock(&est->verrou);
+}
+
+// Cumule une transition dans le cache local, en reportant dans la table la case remplacée
+static void ajouter_cache(t_estimateur *est, t_case_cache *cache, unsigned long long cle) {
+    t_case_cache *c = &cache[alea_melanger(cle) & (TAILLE_CACHE - 1)];
+    if (c->cle != cle) {
+        if (c->cle != 0) ajouter_cle(est, c->cle, c->compte);
+        c->cle = cle;
+        c->compte = 0;
+    }
+    c->compte++;
+}
+
+/** Compteurs locaux d'un thread pendant l'analyse d'un bloc
+**/
+typedef struct {
+    int max_id;
+    unsigned long long observations;
+    unsigned long long transitions;
+    unsigned long long invalides;
+} t_compteurs;
+
+// Analyse un bloc de lignes entières
+static void analyser_bloc(t_estimateur *est, t_case_cache *cache, const char *buf, size_t taille, t_compteurs *cpt) {
+    long long valeur = 0;
+    int dans_valeur = 0;
+    int invalide = 0;
+    int precedent = 0;
+
+    for (size_t k = 0; k <= taille; k++) {
+        char c = (k < taille) ? buf[k] : '\n';
+
+        if (c >= '0' && c <= '9') {
+            if (valeur <= INT_MAX) valeur = valeur * 10 + (c - '0');
+            dans_valeur = 1;
+            continue;
+        }
+        int separateur = (c == ' ' || c == '\t' || c == ',' || c == ';' || c == '\r' || c == '\n');
+        if (!separateur) {
+            // Caractère inattendu : toute la valeur est ignorée
+            invalide = 1;
+            dans_valeur = 1;
+            continue;
+        }
+
+        if (dans_valeur) {
+            if (invalide || valeur < 1 || valeur > INT_MAX) {
+                // Une valeur invalide coupe la séquence
+                cpt->invalides++;
+                precedent = 0;
+            } else {
+                int etat = (int)valeur;
+                cpt->observations++;
+                if (etat > cpt->max_id) cpt->max_id = etat;
+                if (precedent != 0) {
+                    ajouter_cache(est, cache, creer_cle(precedent, etat));
+                    cpt->transitions++;
+                }
+                precedent = etat;
+            }
+            valeur = 0;
+            dans_valeur = 0;
+            invalide = 0;
+        }
+        if (c == '\n') precedent = 0;
+    }
+}
+
+// Boucle d'un thread : lit un bloc de lignes, l'analyse, recommence jusqu'à la fin du flux
+static void* thread_estimation(void *arg) {
+    t_lecture *lecture = arg;
+    t_estimateur *est = lecture->est;
+    t_case_cache *cache = calloc(TAILLE_CACHE, sizeof(t_case_cache));
+    size_t capacite = TAILLE_BLOC + 256;
+    char *buf = malloc(capacite);
+    t_compteurs cpt = {0, 0, 0, 0};
+
+    while (1) {
+        pthread_mutex_lock(&lecture->verrou);
+        size_t taille = fread(buf, 1, TAILLE_BLOC, lecture->flux);
+        // Le bloc est complété jusqu'à la fin de la ligne en cours
+        if (taille == TAILLE_BLOC && buf[taille - 1] != '\n') {
+            int c;
+            while ((c = getc(lecture->flux)) != EOF) {
+                if (taille >= capacite) {
+                    capacite *= 2;
+                    buf = realloc(buf, capacite);
+                }
+                buf[taille++] = (char)c;
+                if (c == '\n') break;
+            }
+        }
+        pthread_mutex_unlock(&lecture->verrou);
+        if (taille == 0) break;
+
+        analyser_bloc(est, cache, buf, taille, &cpt);
+    }
+
+    // Report du cache et des compteurs
+    for (int k = 0; k < TAILLE_CACHE; k++) {
+        if (cache[k].cle != 0) ajouter_cle(est, cache[k].cle, cache[k].compte);
+    }
+    pthread_mutex_lock(&est->verrou);
+    if (cpt.max_id > est->nb_sommets) est->nb_sommets = cpt.max_id;
+    est->nb_observations += cpt.observations;
+    est->nb_transitions += cpt.transitions;
+    est->nb_invalides += cpt.invalides;
+    pthread_mutex_unlock(&est->verrou);
+
+    free(buf);
+    free(cache);
+    return NULL;
+}
+
+//Fonction qui lit des séquences d'états depuis un flux (fichier ou stdin) et compte leurs transitions, renvoie 0 si tout s'est bien passé
+int estimer_flux(t_estimateur *est, FILE *flux, int nb_threads) {
+    if (flux == NULL) return -1;
+    if (nb_threads < 1) nb_threads = 1;
+
+    t_lecture lecture;
+    lecture.est = est;
+    lecture.flux = flux;
+    pthread_mutex_init(&lecture.verrou, NULL);
+
+    pthread_t *threads = malloc(nb_threads * sizeof(pthread_t));
+    for (int t = 0; t < nb_threads; t++) {
+        pthread_create(&threads[t], NULL, thread_estimation, &lecture);
+    }
+    for (int t = 0; t < nb_threads; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    free(threads);
+    pthread_mutex_destroy(&lecture.verrou);
+
+    return ferror(flux) ? -1 : 0;
+}
+
+static int comparer_cases(const void *a, const void *b) {
+    unsigned long long x = ((const t_case_cache*)a)->cle;
+    unsigned long long y = ((const t_case_cache*)b)->cle;
+    return (x > y) - (x < y);
+}
+
+//Fonction qui construit la chaîne estimée : proba(i -> j) = nombre(i -> j) / nombre de transitions sortant de i
+//Les états gardent leur numéro ; un état qu'aucune transition ne quitte reçoit une boucle de probabilité 1
+//(sinon sa ligne serait nulle) et est compté dans nb_absorbants, ceux d'aucune transition dans nb_absents
+listeAdj estimateur_vers_chaine(t_estimateur *est, int *nb_absorbants, int *nb_absents) {
+    int n = est->nb_sommets;
+    listeAdj g = createListeAdj(n);
+
+    // Toutes les transitions, triées par (depart, arrivee) : le résultat ne dépend pas de l'ordre de lecture
+    size_t nb = 0;
+    for (int i = 0; i < NB_FRAGMENTS; i++) nb += est->fragments[i].nb;
+    t_case_cache *cases = malloc((nb > 0 ? nb : 1) * sizeof(t_case_cache));
+    size_t k = 0;
+    for (int i = 0; i < NB_FRAGMENTS; i++) {
+        t_fragment *f = &est->fragments[i];
+        for (size_t p = 0; p < f->capacite; p++) {
+            if (f->cles[p] == 0) continue;
+            cases[k].cle = f->cles[p];
+            cases[k].compte = f->comptes[p];
+            k++;
+        }
+    }
+    qsort(cases, nb, sizeof(t_case_cache), comparer_cases);
+
+    unsigned long long *total = calloc(n > 0 ? n : 1, sizeof(unsigned long long));
+    char *arrivee_vue = calloc(n > 0 ? n : 1, sizeof(char));
+    for (k = 0; k < nb; k++) {
+        total[(cases[k].cle >> 32) - 1] += cases[k].compte;
+        arrivee_vue[(cases[k].cle & 0xffffffffu) - 1] = 1;
+    }
+
+    // addCell ajoute en tête : parcours à l'envers pour garder les arrivées dans l'ordre croissant
+    for (k = nb; k > 0; k--) {
+        int depart = (int)(cases[k - 1].cle >> 32);
+        int arrivee = (int)(cases[k - 1].cle & 0xffffffffu);
+        addCell(&g.tab_liste[depart - 1], arrivee, (float)((double)cases[k - 1].compte / (double)total[depart - 1]));
+    }
+
+    // Un état jamais quitté dans les observations devient absorbant
+    *nb_absorbants = 0;
+    *nb_absents = 0;
+    for (int i = 0; i < n; i++) {
+        if (total[i] != 0) continue;
+        addCell(&g.tab_liste[i], i + 1, 1.0f);
+        (*nb_absorbants)++;
+        if (!arrivee_vue[i]) (*nb_absents)++;
+    }
+
+    free(arrivee_vue);
+    free(total);
+    free(cases);
+    return g;
+}
+
+// Libère un estimateur
+void liberer_estimateur(t_estimateur *est) {
+    if (est == NULL) return;
+    for (int i = 0; i < NB_FRAGMENTS; i++) {
+        free(est->fragments[i].cles);
+        free(est->fragments[i].comptes);
+        pthread_mutex_destroy(&est->fragments[i].verrou);
+    }
+    pthread_mutex_destroy(&est->verrou);
+    free(est);
+}
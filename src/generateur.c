@@ -0,0 +1,158 @@
+#include "generateur.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *noms_generateurs[GEN_NB] = {
+    "aleatoire", "bande", "anneau", "petites_scc", "chemin", "bande_melangee"
+};
+
+// Générateur pseudo-aléatoire local (splitmix64) : reproductible et sans état global
+static unsigned long long suivant_alea(unsigned long long *etat) {
+    unsigned long long z = (*etat += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+// Réel uniforme dans ]0, 1]
+static double alea_reel(unsigned long long *etat) {
+    return ((suivant_alea(etat) >> 11) + 1) * (1.0 / 9007199254740992.0);
+}
+
+// Entier uniforme dans [0, borne[
+static int alea_entier(unsigned long long *etat, int borne) {
+    return (int)(suivant_alea(etat) % (unsigned long long)borne);
+}
+
+const char* nom_generateur(t_type_generateur type) {
+    return (type >= 0 && type < GEN_NB) ? noms_generateurs[type] : "inconnu";
+}
+
+// Renvoie le type correspondant au nom, -1 s'il est inconnu
+int generateur_depuis_nom(const char *nom) {
+    for (int t = 0; t < GEN_NB; t++) {
+        if (strcmp(nom, noms_generateurs[t]) == 0) return t;
+    }
+    return -1;
+}
+
+// Ajoute les arêtes i -> cibles[k] avec des poids aléatoires normalisés (somme = 1)
+static void ajouter_ligne(listeAdj *g, int i, const int *cibles, int nb, unsigned long long *etat) {
+    double poids[nb > 0 ? nb : 1];
+    double somme = 0.0;
+    for (int k = 0; k < nb; k++) {
+        poids[k] = alea_reel(etat);
+        somme += poids[k];
+    }
+    for (int k = 0; k < nb; k++) {
+        addCell(&g->tab_liste[i], cibles[k] + 1, (float)(poids[k] / somme));
+    }
+}
+
+//Fonction qui génère une chaîne de Markov synthétique de n sommets
+listeAdj generer_chaine(t_type_generateur type, int n, int degre, unsigned long long graine) {
+    unsigned long long etat = graine;
+    if (degre < 1) degre = 1;
+
+    // L'anneau a besoin d'un nombre de sommets multiple de la période
+    if (type == GEN_ANNEAU && n % degre != 0) {
+        n -= n % degre;
+        if (n == 0) n = degre;
+    }
+
+    listeAdj g = createListeAdj(n);
+    int *cibles = malloc((2 * degre + 2) * sizeof(int));
+
+    // Bande mélangée : le sommet i de la bande reçoit le numéro numero[i] (Fisher-Yates)
+    int *numero = NULL;
+    if (type == GEN_BANDE_MELANGEE) {
+        numero = malloc(n * sizeof(int));
+        for (int i = 0; i < n; i++) numero[i] = i;
+        for (int i = n - 1; i > 0; i--) {
+            int k = alea_entier(&etat, i + 1);
+            int tmp = numero[i];
+            numero[i] = numero[k];
+            numero[k] = tmp;
+        }
+    }
+
+    for (int i = 0; i < n; i++) {
+        int nb = 0;
+
+        switch (type) {
+        case GEN_ALEATOIRE:
+            // degre successeurs distincts (ou tous les sommets si le graphe est petit)
+            while (nb < degre && nb < n) {
+                int c = alea_entier(&etat, n);
+                int deja = 0;
+                for (int k = 0; k < nb; k++) deja |= (cibles[k] == c);
+                if (!deja) cibles[nb++] = c;
+            }
+            break;
+
+        case GEN_BANDE:
+        case GEN_BANDE_MELANGEE: {
+            int demi = (degre + 1) / 2;
+            for (int c = i - demi; c <= i + demi; c++) {
+                if (c >= 0 && c < n) cibles[nb++] = c;
+            }
+            break;
+        }
+
+        case GEN_ANNEAU: {
+            // Le successeur i+1 garantit l'irréductibilité, un second successeur dans la couche suivante
+            int d = degre;
+            int suivant = (i + 1) % n;
+            cibles[nb++] = suivant;
+            int nb_couche = n / d;
+            int autre = ((suivant % d) + d * alea_entier(&etat, nb_couche)) % n;
+            if (autre != suivant) cibles[nb++] = autre;
+            break;
+        }
+
+        case GEN_PETITES_SCC: {
+            // Cycle interne à la classe, plus une sortie vers l'une des trois classes suivantes
+            int s = (degre < 2) ? 2 : degre;
+            int bloc = i / s;
+            int debut = bloc * s;
+            int fin = (debut + s < n) ? debut + s : n;
+            cibles[nb++] = (i + 1 < fin) ? i + 1 : debut;
+            if (fin - debut > 2) {
+                int c = debut + alea_entier(&etat, fin - debut);
+                if (c != cibles[0]) cibles[nb++] = c;
+            }
+            int nb_blocs = (n + s - 1) / s;
+            if (bloc < nb_blocs - 1) {
+                int bloc_suiv = bloc + 1 + alea_entier(&etat, 3);
+                if (bloc_suiv >= nb_blocs) bloc_suiv = nb_blocs - 1;
+                int d2 = bloc_suiv * s;
+                int f2 = (d2 + s < n) ? d2 + s : n;
+                cibles[nb++] = d2 + alea_entier(&etat, f2 - d2);
+            }
+            break;
+        }
+
+        case GEN_CHEMIN:
+            cibles[nb++] = i;
+            if (i + 1 < n) cibles[nb++] = i + 1;
+            break;
+
+        default:
+            break;
+        }
+
+        if (type == GEN_CHEMIN && i + 1 == n) {
+            addCell(&g.tab_liste[i], i + 1, 1.0f);
+        } else if (numero != NULL) {
+            for (int k = 0; k < nb; k++) cibles[k] = numero[cibles[k]];
+            ajouter_ligne(&g, numero[i], cibles, nb, &etat);
+        } else {
+            ajouter_ligne(&g, i, cibles, nb, &etat);
+        }
+    }
+
+    free(numero);
+    free(cibles);
+    return g;
+}
@@ -1,18 +1,59 @@
 #include <malloc.h>
+#include <string.h>
 #include "hasse.h"
 #include "list.h"
 #include "tarjan.h"
 #include "utils.h"
+#include "erreurs.h"
+
+// Ensemble de couples (Ci, Cj) déjà vus : table de hachage à adressage ouvert
+typedef struct {
+    unsigned long long *cles;
+    size_t capacite;
+    size_t nb;
+} t_ensemble_liens;
+
+static size_t hacher_lien(unsigned long long cle, size_t masque) {
+    cle ^= cle >> 33;
+    cle *= 0xff51afd7ed558ccdULL;
+    cle ^= cle >> 33;
+    return (size_t)cle & masque;
+}
+
+// Insère le couple, renvoie 1 s'il était absent
+static int inserer_lien(t_ensemble_liens *e, int from, int to) {
+    // Agrandissement à 50% de remplissage
+    if (2 * (e->nb + 1) > e->capacite) {
+        size_t ancienne = e->capacite;
+        unsigned long long *anciennes_cles = e->cles;
+        e->capacite = ancienne ? 2 * ancienne : 64;
+        e->cles = malloc(e->capacite * sizeof(unsigned long long));
+        memset(e->cles, 0xff, e->capacite * sizeof(unsigned long long));
+        for (size_t k = 0; k < ancienne; k++) {
+            if (anciennes_cles[k] == ~0ULL) continue;
+            size_t pos = hacher_lien(anciennes_cles[k], e->capacite - 1);
+            while (e->cles[pos] != ~0ULL) pos = (pos + 1) & (e->capacite - 1);
+            e->cles[pos] = anciennes_cles[k];
+        }
+        free(anciennes_cles);
+    }
+
+    unsigned long long cle = ((unsigned long long)(unsigned int)from << 32) | (unsigned int)to;
+    size_t pos = hacher_lien(cle, e->capacite - 1);
+    while (e->cles[pos] != ~0ULL) {
+        if (e->cles[pos] == cle) return 0;
+        pos = (pos + 1) & (e->capacite - 1);
+    }
+    e->cles[pos] = cle;
+    e->nb++;
+    return 1;
+}
 
 t_link_array* rencenser(listeAdj *g, int *t_link_corresp) {
     t_link_array *link = creer_list_link(g->nb_sommets);
 
-    //Création d'une simple matrice pour stockage de ci -> cj
-    int max_classes = g->nb_sommets; // worst case
-    int **seen = malloc(max_classes * sizeof(int*));
-    for (int i = 0; i < max_classes; i++) {
-        seen[i] = calloc(max_classes, sizeof(int));
-    }
+    //Ensemble des liens ci -> cj déjà rencontrés (mémoire proportionnelle au nombre de liens)
+    t_ensemble_liens seen = {NULL, 0, 0};
 
     for (int i=0; i < g->nb_sommets; i++) {
         int Ci = t_link_corresp[i];
@@ -22,29 +63,25 @@ t_link_array* rencenser(listeAdj *g, int *t_link_corresp) {
             int j = voisin->sommet_arrivee -1;
             int Cj = t_link_corresp[j];
 
-            if (Ci != Cj && !seen[Ci][Cj]) {
+            if (Ci != Cj && inserer_lien(&seen, Ci, Cj)) {
                 ajouter_link(link, Ci, Cj);
-                seen[Ci][Cj] = 1; // Mark as seen
             }
             voisin = voisin->suivante;
         }
     }
 
-    //libere la matrice nouvellement crée
-    for (int i = 0; i < max_classes; i++) {
-        free(seen[i]);
-    }
-    free(seen);
+    //libere l'ensemble
+    free(seen.cles);
 
     return link;
 }
 
-//Création d'un tableau de liens entre classes
+//Création d'un tableau de liens entre classes (agrandi au besoin par ajouter_link)
 t_link_array* creer_list_link(int nb_sommets) {
     t_link_array *link = malloc(sizeof(t_link_array));
-    link->links=malloc(nb_sommets * nb_sommets * sizeof(t_link));
+    link->alloc_size = (nb_sommets > 0) ? nb_sommets : 1;
+    link->links = malloc(link->alloc_size * sizeof(t_link));
     link->log_size = 0;
-    link->alloc_size = nb_sommets * nb_sommets;
     return link;
 }
 
@@ -62,53 +99,51 @@ int* creer_tab_corresp(t_partition *partition, int nb_sommets) {
 
 //Rajout de chaque lien Ci -> Cj
 void ajouter_link(t_link_array *link, int from, int to) {
-    if (link->log_size < link->alloc_size) {
-        link->links[link->log_size].from =from;
-        link->links[link->log_size].to =to;
-        link->log_size++;
+    //Si le tableau est plein, on l'aggrandit
+    if (link->log_size >= link->alloc_size) {
+        link->alloc_size *= 2;
+        link->links = realloc(link->links, link->alloc_size * sizeof(t_link));
     }
+    link->links[link->log_size].from =from;
+    link->links[link->log_size].to =to;
+    link->log_size++;
 }
 
-//generer le fichier Mermaid du diagramme de Hasse
-void genererHasseMermaid(t_partition *partition, t_link_array *liens, const char* nomFichier, int avecRedondances) {
-    FILE *file = fopen(nomFichier, "w");
+//generer le fichier Mermaid du diagramme de Hasse (MARKOV_ERR_FICHIER si le fichier ne peut pas être écrit)
+int genererHasseMermaid(t_partition *partition, t_link_array *liens, const char* nomFichier, int avecRedondances) {
+    t_tampon *file = ouvrir_tampon(nomFichier, 0);
+    if (!file) {
+        return MARKOV_ERR_FICHIER;
+    }
 
     // En-tête exact comme demandé
-    fprintf(file, "---\n");
-    fprintf(file, "config:\n");
-    fprintf(file, "   layout: elk\n");
-    fprintf(file, "   theme: mc\n");
-    fprintf(file, "   look: classic\n");
-    fprintf(file, "---\n");
-    fprintf(file, "\nflowchart LR\n");
-
-    // Tableau stocke ID des classes
-    char** id_classes = malloc(partition->taille * sizeof(char*));
-
-    // Générer ID pour chaque classe
-    for (int i = 0; i < partition->taille; i++) {
-        id_classes[i] = getID(i + 1);
-    }
+    tampon_chaine(file, "---\n"
+                        "config:\n"
+                        "   layout: elk\n"
+                        "   theme: mc\n"
+                        "   look: classic\n"
+                        "---\n"
+                        "\nflowchart LR\n");
 
     // Sommets du diagramme de Hasse
     for (int i = 0; i < partition->taille; i++) {
-        fprintf(file, "%s[\"", id_classes[i]);
-        fprintf(file, "{");
+        tampon_id(file, i + 1);
+        tampon_ecrire(file, "[\"{", 3);
 
         // Sommets de la classe
         for (int j = 0; j < partition->classes[i].taille; j++) {
-            fprintf(file, "%d", partition->classes[i].sommets[j]);
+            tampon_entier(file, partition->classes[i].sommets[j]);
             if (j < partition->classes[i].taille - 1) {
-                fprintf(file, ",");
+                tampon_ecrire(file, ",", 1);
             }
         }
-        fprintf(file, "}\"]\n");
+        tampon_ecrire(file, "}\"]\n", 4);
     }
-    fprintf(file, "\n");
+    tampon_ecrire(file, "\n", 1);
 
     // Suppression des redondances
     if (!avecRedondances) {
-        removeTransitiveLinks(liens);
+        supprimer_liens_transitifs(liens);
     }
 
     // Liens entre classes
@@ -117,11 +152,92 @@ void genererHasseMermaid(t_partition *partition, t_link_array *liens, const char
         int to = liens->links[i].to;
 
         if (from >= 0 && from < partition->taille && to >= 0 && to < partition->taille) {
-            fprintf(file, "%s --> %s\n", getID(from + 1), getID(to + 1));
+            tampon_id(file, from + 1);
+            tampon_ecrire(file, " --> ", 5);
+            tampon_id(file, to + 1);
+            tampon_ecrire(file, "\n", 1);
         }
     }
 
-    fclose(file);
+    return (fermer_tampon(file) == 0) ? MARKOV_OK : MARKOV_ERR_FICHIER;
+}
+
+// Ordre lexicographique (from, to) sur les liens
+static int comparer_links(const void *a, const void *b) {
+    const t_link *la = a, *lb = b;
+    if (la->from != lb->from) return (la->from > lb->from) - (la->from < lb->from);
+    return (la->to > lb->to) - (la->to < lb->to);
+}
+
+//generer le graphe Mermaid, réduit au graphe des classes s'il a plus de seuil_condensation arêtes
+//(MARKOV_ERR_FICHIER si le fichier ne peut pas être écrit)
+int genererMermaidGraphe(listeAdj *g, t_partition *partition, const char* nomFichier, int seuil_condensation) {
+    int nb_aretes = 0;
+    for (int i = 0; i < g->nb_sommets; i++) {
+        for (cell *c = g->tab_liste[i].head; c != NULL; c = c->suivante) nb_aretes++;
+    }
+
+    // Petit graphe (ou pas de partition) : sortie identique à genererFichierMermaid
+    if (partition == NULL || seuil_condensation < 0 || nb_aretes <= seuil_condensation) {
+        return genererFichierMermaid(*g, nomFichier);
+    }
+
+    t_tampon *file = ouvrir_tampon(nomFichier, 0);
+    if (!file) {
+        return MARKOV_ERR_FICHIER;
+    }
+
+    tampon_chaine(file, "---\n"
+                        "config:\n"
+                        "  layout: elk\n"
+                        "  theme: neo\n"
+                        "  look: neo\n"
+                        "---\n"
+                        "flowchart LR\n");
+
+    // Un noeud par classe : nom et nombre de sommets
+    for (int i = 0; i < partition->taille; i++) {
+        tampon_id(file, i + 1);
+        tampon_ecrire(file, "((\"", 3);
+        tampon_chaine(file, partition->classes[i].nom);
+        tampon_ecrire(file, " : ", 3);
+        tampon_entier(file, partition->classes[i].taille);
+        tampon_ecrire(file, "\"))\n", 4);
+    }
+
+    // Un arc par couple de classes reliées, annoté par le nombre d'arêtes du graphe d'origine
+    int *corresp = creer_tab_corresp(partition, g->nb_sommets);
+    t_link_array *liens = rencenser(g, corresp);
+    int *nb_par_lien = calloc(liens->log_size > 0 ? liens->log_size : 1, sizeof(int));
+
+    // Liens triés par (from, to) pour retrouver chaque lien par recherche dichotomique
+    qsort(liens->links, liens->log_size, sizeof(t_link), comparer_links);
+    for (int i = 0; i < g->nb_sommets; i++) {
+        int Ci = corresp[i];
+        for (cell *c = g->tab_liste[i].head; c != NULL; c = c->suivante) {
+            int Cj = corresp[c->sommet_arrivee - 1];
+            if (Ci == Cj) continue;
+            t_link cle = {Ci, Cj};
+            t_link *trouve = bsearch(&cle, liens->links, liens->log_size, sizeof(t_link), comparer_links);
+            if (trouve != NULL) nb_par_lien[trouve - liens->links]++;
+        }
+    }
+
+    for (int l = 0; l < liens->log_size; l++) {
+        tampon_id(file, liens->links[l].from + 1);
+        tampon_ecrire(file, " -->|", 5);
+        tampon_entier(file, nb_par_lien[l]);
+        tampon_ecrire(file, "|", 1);
+        tampon_id(file, liens->links[l].to + 1);
+        tampon_ecrire(file, "\n", 1);
+    }
+
+    free(nb_par_lien);
+    free(liens->links);
+    free(liens);
+    free(corresp);
+
+    return (fermer_tampon(file) == 0) ? MARKOV_OK : MARKOV_ERR_FICHIER;
 }
 
 //Supprimer les redondances
@@ -165,19 +281,83 @@ void removeTransitiveLinks(t_link_array *p_link_array)
     }
 }
 
-//Fonction pour analyser les caractéristiques de notre graphe
-void analyserCarac(t_partition *partition, listeAdj *g) {
-    printf("\nCaracteristique du graphe\n");
+static int comparer_entiers(const void *a, const void *b) {
+    int x = *(const int*)a, y = *(const int*)b;
+    return (x > y) - (x < y);
+}
 
-    // Tableau pour savoir à quelle classe appartient chaque sommet
-    int *IDclasse = malloc(g->nb_sommets * sizeof(int));
-    for (int i = 0; i < partition->taille; i++) {
-        for (int j = 0; j < partition->classes[i].taille; j++) {
-            IDclasse[partition->classes[i].sommets[j] - 1] = i;
+// Position de la classe to parmi les arrivées triées arrivees[debut..fin-1], -1 si elle est absente
+static int chercher_arrivee(const int *arrivees, int debut, int fin, int to) {
+    int borne = fin;
+    while (debut < fin) {
+        int milieu = debut + (fin - debut) / 2;
+        if (arrivees[milieu] < to) debut = milieu + 1;
+        else fin = milieu;
+    }
+    return (debut < borne && arrivees[debut] == to) ? debut : -1;
+}
+
+//Supprimer les redondances comme removeTransitiveLinks (même parcours, mêmes liens retirés, même ordre
+//final) sans parcourir tous les liens pour chacun : les liens sont rangés par classe de départ, triés par
+//arrivée, et chaque chemin a -> b -> c restant est cherché par dichotomie. Les liens doivent être
+//distincts et sans boucle, comme ceux de rencenser
+void supprimer_liens_transitifs(t_link_array *p_link_array) {
+    int nb = p_link_array->log_size;
+    t_link *links = p_link_array->links;
+    if (nb < 2) return;
+
+    int nb_classes = 0;
+    for (int l = 0; l < nb; l++) {
+        if (links[l].from >= nb_classes) nb_classes = links[l].from + 1;
+        if (links[l].to >= nb_classes) nb_classes = links[l].to + 1;
+    }
+
+    // Arrivées des liens de chaque classe de départ (format CSR) et liens encore présents
+    int *debut = calloc((size_t)nb_classes + 1, sizeof(int));
+    int *position = malloc(nb_classes * sizeof(int));
+    int *arrivees = malloc(nb * sizeof(int));
+    char *present = malloc(nb * sizeof(char));
+    for (int l = 0; l < nb; l++) debut[links[l].from + 1]++;
+    for (int c = 0; c < nb_classes; c++) debut[c + 1] += debut[c];
+    memcpy(position, debut, nb_classes * sizeof(int));
+    for (int l = 0; l < nb; l++) arrivees[position[links[l].from]++] = links[l].to;
+    for (int c = 0; c < nb_classes; c++) {
+        qsort(arrivees + debut[c], debut[c + 1] - debut[c], sizeof(int), comparer_entiers);
+    }
+    memset(present, 1, nb);
+
+    int i = 0;
+    while (i < p_link_array->log_size) {
+        int a = links[i].from;
+        int c = links[i].to;
+        int to_remove = 0;
+        for (int e = debut[a]; e < debut[a + 1] && !to_remove; e++) {
+            int b = arrivees[e];
+            if (!present[e] || b == c) continue;
+            int k = chercher_arrivee(arrivees, debut[b], debut[b + 1], c);
+            to_remove = (k >= 0 && present[k]);
+        }
+        if (to_remove) {
+            present[chercher_arrivee(arrivees, debut[a], debut[a + 1], c)] = 0;
+            links[i] = links[p_link_array->log_size - 1];
+            p_link_array->log_size--;
+        } else {
+            i++;
         }
     }
 
-    // Vérifier si chaque classe est persistante
+    free(present);
+    free(arrivees);
+    free(position);
+    free(debut);
+}
+
+//Fonction qui indique pour chaque classe si elle est persistante (1) ou transitoire (0)
+int* calculer_persistance(t_partition *partition, listeAdj *g) {
+    // Tableau pour savoir à quelle classe appartient chaque sommet
+    int *IDclasse = creer_tab_corresp(partition, g->nb_sommets);
+
+    // Une classe est persistante si aucune arête ne sort de la classe
     int *estPersistante = malloc(partition->taille * sizeof(int));
     for (int i = 0; i < partition->taille; i++) {
         estPersistante[i] = 1;
@@ -194,41 +374,7 @@ void analyserCarac(t_partition *partition, listeAdj *g) {
         }
     }
 
-    // Affichage
-    printf("\n");
-    for (int i = 0; i < partition->taille; i++) {
-        printf("La classe {");
-        for (int j = 0; j < partition->classes[i].taille; j++) {
-            printf("%d%s", partition->classes[i].sommets[j],
-                   (j < partition->classes[i].taille - 1) ? "," : "");
-        }
-        printf("} est %s", estPersistante[i] ? "persistante" : "transitoire");
-
-        // Affichage des états
-        if (partition->classes[i].taille == 1) {
-            printf(" : l'etat %d est %s", partition->classes[i].sommets[0],
-                   estPersistante[i] ? "persistant" : "transitoire");
-            if (estPersistante[i]) printf(" : l'etat %d est absorbant", partition->classes[i].sommets[0]);
-        } else {
-            printf(" : les etats ");
-            for (int j = 0; j < partition->classes[i].taille; j++) {
-                printf("%d", partition->classes[i].sommets[j]);
-                if (j < partition->classes[i].taille - 2) printf(", ");
-                else if (j == partition->classes[i].taille - 2) printf(" et ");
-            }
-            printf(" sont %s", estPersistante[i] ? "persistants" : "transitoires");
-        }
-        printf(";\n");
-    }
-
-    // Irréductibilité
-    printf("Le graphe de Markov ");
-    if (partition->taille == 1) {
-        printf("est irreductible.\n");
-    } else {
-        printf("n'est pas irreductible.\n");
-    }
-
     free(IDclasse);
-    free(estPersistante);
-}
\ No newline at end of file
+    return estPersistante;
+}
+
@@ -0,0 +1,136 @@
+#include "instrum.h"
+#include "sortie.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+// Temps en secondes sur une horloge monotone (insensible aux changements d'heure)
+double horloge_monotone(void) {
+#if defined(_WIN32)
+    LARGE_INTEGER freq, compteur;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&compteur);
+    return (double)compteur.QuadPart / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+#endif
+}
+
+// Pic de mémoire résidente du processus en Ko (-1 si indisponible)
+long rss_pic_ko(void) {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) {
+        return (long)(pmc.PeakWorkingSetSize / 1024);
+    }
+    return -1;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return -1;
+#if defined(__APPLE__)
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+#endif
+}
+
+// Octets actuellement alloués par malloc (-1 si indisponible)
+long long tas_utilise(void) {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    struct mallinfo2 mi = mallinfo2();
+    return (long long)mi.uordblks + (long long)mi.hblkhd;
+#else
+    return -1;
+#endif
+}
+
+void profil_init(t_profil *p, const char *nom) {
+    if (p == NULL) return;
+    snprintf(p->nom, sizeof(p->nom), "%s", nom);
+    p->nb_etapes = 0;
+    p->debut = horloge_monotone();
+    p->concurrent = 0;
+}
+
+// Ouvre la mesure d'une étape, renvoie son indice (-1 si pas de profil ou plus de place)
+int profil_debut(t_profil *p, const char *nom) {
+    if (p == NULL || p->nb_etapes >= PROFIL_MAX_ETAPES) return -1;
+
+    t_mesure_etape *e = &p->etapes[p->nb_etapes];
+    snprintf(e->nom, sizeof(e->nom), "%s", nom);
+    e->sommets = 0;
+    e->aretes = 0;
+    e->duree = 0.0;
+    e->tas_debut = tas_utilise();
+    e->debut = horloge_monotone();
+    return p->nb_etapes++;
+}
+
+// Ferme la mesure d'une étape
+void profil_fin(t_profil *p, int idx, long long sommets, long long aretes) {
+    if (p == NULL || idx < 0) return;
+
+    t_mesure_etape *e = &p->etapes[idx];
+    e->duree = horloge_monotone() - e->debut;
+    e->sommets = sommets;
+    e->aretes = aretes;
+    e->rss_pic_ko = rss_pic_ko();
+    long long tas = tas_utilise();
+    e->tas_delta = (tas >= 0 && e->tas_debut >= 0) ? tas - e->tas_debut : 0;
+}
+
+// Écrit un profil sous forme d'objet JSON (sans les mesures de mémoire du processus si l'analyse
+// a tourné en même temps que d'autres)
+void profil_ecrire_json(const t_profil *p, FILE *out) {
+    double total = horloge_monotone() - p->debut;
+
+    fprintf(out, "{\"chaine\":");
+    sortie_chaine_json(out, p->nom);
+    fprintf(out, ",\"duree_totale_s\":%.9f,", total);
+    if (!p->concurrent) fprintf(out, "\"rss_pic_ko\":%ld,", rss_pic_ko());
+    fprintf(out, "\"etapes\":[");
+    for (int i = 0; i < p->nb_etapes; i++) {
+        const t_mesure_etape *e = &p->etapes[i];
+        double debit_sommets = (e->duree > 0.0) ? e->sommets / e->duree : 0.0;
+        double debit_aretes = (e->duree > 0.0) ? e->aretes / e->duree : 0.0;
+        fprintf(out, "%s{\"nom\":", (i > 0) ? "," : "");
+        sortie_chaine_json(out, e->nom);
+        fprintf(out, ",\"duree_s\":%.9f,\"sommets\":%lld,\"aretes\":%lld,"
+                     "\"sommets_par_s\":%.1f,\"aretes_par_s\":%.1f",
+                e->duree, e->sommets, e->aretes, debit_sommets, debit_aretes);
+        if (!p->concurrent) fprintf(out, ",\"rss_pic_ko\":%ld,\"tas_delta_octets\":%lld", e->rss_pic_ko, e->tas_delta);
+        fprintf(out, "}");
+    }
+    fprintf(out, "]}");
+}
+
+// Écrit un ou plusieurs profils dans un fichier JSON ({"profils":[...]}), renvoie 0 si tout s'est bien passé
+int profil_sauvegarder_json(const t_profil *profils, int nb, const char *nomFichier) {
+    FILE *out = fopen(nomFichier, "w");
+    if (out == NULL) {
+        return -1;
+    }
+    fprintf(out, "{\"profils\":[");
+    for (int i = 0; i < nb; i++) {
+        if (i > 0) fprintf(out, ",");
+        fprintf(out, "\n");
+        profil_ecrire_json(&profils[i], out);
+    }
+    fprintf(out, "\n]}\n");
+    return fclose(out) == 0 ? 0 : -1;
+}
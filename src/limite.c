@@ -0,0 +1,222 @@
+#include "limite.h"
+#include <stdlib.h>
+#include <math.h>
+#include "hasse.h"
+#include "periode.h"
+
+// Loi stationnaire d'une classe persistante par itération de la chaîne paresseuse (P + I) / 2 :
+// même loi stationnaire que P, mais apériodique, donc l'itération converge même si la classe est périodique.
+// pi et suivant sont indexés par sommet et seules les cases de la classe sont lues ou écrites
+// (plusieurs classes peuvent être traitées en parallèle sur les mêmes tableaux)
+int stationnaire_classe(listeAdj *g, t_classe *classe, double *pi, double *suivant,
+                               double epsilon, int max_iter, double *residu) {
+    int taille = classe->taille;
+    for (int s = 0; s < taille; s++) pi[classe->sommets[s] - 1] = 1.0 / taille;
+    *residu = 0.0;
+    if (taille == 1) return 0;
+
+    int iter = 0;
+    do {
+        for (int s = 0; s < taille; s++) {
+            int i = classe->sommets[s] - 1;
+            suivant[i] = 0.5 * pi[i];
+        }
+        // Une classe persistante est fermée : toutes les arêtes restent dans la classe
+        for (int s = 0; s < taille; s++) {
+            int i = classe->sommets[s] - 1;
+            double demi = 0.5 * pi[i];
+            for (cell *c = g->tab_liste[i].head; c != NULL; c = c->suivante) {
+                suivant[c->sommet_arrivee - 1] += demi * c->proba;
+            }
+        }
+
+        // Renormalisation (les probabilités lues en float ne somment pas exactement à 1)
+        double somme = 0.0;
+        for (int s = 0; s < taille; s++) somme += suivant[classe->sommets[s] - 1];
+        double ecart = 0.0;
+        for (int s = 0; s < taille; s++) {
+            int i = classe->sommets[s] - 1;
+            double nouv = suivant[i] / somme;
+            ecart += fabs(nouv - pi[i]);
+            pi[i] = nouv;
+        }
+        *residu = ecart;
+        iter++;
+    } while (*residu > epsilon && iter < max_iter);
+
+    return iter;
+}
+
+static int ppcm(int a, int b) {
+    int x = a, y = b;
+    while (y != 0) {
+        int r = x % y;
+        x = y;
+        y = r;
+    }
+    return a / x * b;
+}
+
+// Un balayage de Gauss-Seidel des phases d'entrée sur une classe transitoire :
+// phase_i[a] = somme des P_ij * phase_j[a + 1] (un pas de plus avant l'entrée), renvoie le plus grand écart
+static double balayer_phases(listeAdj *g, t_classe *classe, t_limite *lim, double *acc) {
+    int D = lim->nb_phases;
+    int K = lim->absorption->nb_persistantes;
+    double ecart_max = 0.0;
+
+    for (int s = 0; s < classe->taille; s++) {
+        int i = classe->sommets[s] - 1;
+        for (int x = 0; x < D; x++) acc[x] = 0.0;
+
+        for (cell *c = g->tab_liste[i].head; c != NULL; c = c->suivante) {
+            const double *hj = &lim->phase[(size_t)(c->sommet_arrivee - 1) * D];
+            for (int k = 0; k < K; k++) {
+                int d = lim->periode_classe[k];
+                if (d == 1) continue;
+                int o = lim->decalage[k];
+                for (int a = 0; a < d; a++) acc[o + a] += c->proba * hj[o + (a + 1) % d];
+            }
+        }
+
+        double *hi = &lim->phase[(size_t)i * D];
+        for (int x = 0; x < D; x++) {
+            double ecart = fabs(acc[x] - hi[x]);
+            if (ecart > ecart_max) ecart_max = ecart;
+            hi[x] = acc[x];
+        }
+    }
+    return ecart_max;
+}
+
+// Phases d'entrée dans les classes persistantes périodiques (même ordre de résolution que l'absorption)
+static void calculer_phases(listeAdj *g, t_partition *partition, t_limite *lim, double epsilon, int max_iter) {
+    int n = lim->nb_sommets;
+    int D = lim->nb_phases;
+    lim->phase = calloc((size_t)n * D, sizeof(double));
+    double *acc = malloc(D * sizeof(double));
+
+    // Un sommet persistant est dans sa classe dès l'instant 0 : sa phase est sa position
+    for (int j = 0; j < n; j++) {
+        int k = lim->rang[j];
+        if (k >= 0 && lim->decalage[k] >= 0) lim->phase[(size_t)j * D + lim->decalage[k] + lim->position[j]] = 1.0;
+    }
+
+    for (int c = 0; c < partition->taille; c++) {
+        if (lim->absorption->rang_persistante[c] >= 0) continue;
+        double ecart;
+        int iter = 0;
+        do {
+            ecart = balayer_phases(g, &partition->classes[c], lim, acc);
+            iter++;
+        } while (ecart > epsilon && iter < max_iter);
+        lim->iterations += iter;
+        if (ecart > lim->residu) lim->residu = ecart;
+    }
+    free(acc);
+}
+
+//Fonction qui calcule la limite de M^k classe par classe (probabilités d'absorption et lois stationnaires)
+t_limite* calculer_limite(listeAdj *g, t_partition *partition, double epsilon, int max_iter) {
+    int n = g->nb_sommets;
+    t_limite *lim = malloc(sizeof(t_limite));
+    if (lim == NULL) return NULL;
+    lim->nb_sommets = n;
+
+    // Classes transitoires, dans l'ordre topologique inverse donné par Tarjan
+    lim->absorption = calculer_absorption(g, partition, epsilon, max_iter);
+    lim->iterations = lim->absorption->iterations;
+    lim->residu = lim->absorption->residu;
+
+    lim->rang = malloc((n > 0 ? n : 1) * sizeof(int));
+    lim->stationnaire = calloc((n > 0 ? n : 1), sizeof(double));
+    double *suivant = malloc((n > 0 ? n : 1) * sizeof(double));
+    int *corresp = creer_tab_corresp(partition, n);
+    for (int i = 0; i < n; i++) lim->rang[i] = lim->absorption->rang_persistante[corresp[i]];
+
+    // Classes persistantes : chacune indépendamment, pour un coût lié à sa taille
+    for (int k = 0; k < lim->absorption->nb_persistantes; k++) {
+        t_classe *classe = &partition->classes[lim->absorption->classes_persistantes[k]];
+        double residu;
+        lim->iterations += stationnaire_classe(g, classe, lim->stationnaire, suivant, epsilon, max_iter, &residu);
+        if (residu > lim->residu) lim->residu = residu;
+    }
+
+    // Périodes connues avant toute itération : on sait d'emblée si M^k converge
+    int K = lim->absorption->nb_persistantes;
+    int *periodes = malloc((partition->taille > 0 ? partition->taille : 1) * sizeof(int));
+    lim->position = malloc((n > 0 ? n : 1) * sizeof(int));
+    lim->periode_classe = malloc((K > 0 ? K : 1) * sizeof(int));
+    lim->decalage = malloc((K > 0 ? K : 1) * sizeof(int));
+    calculer_periodes(g, partition, periodes, lim->position);
+    lim->periode = 1;
+    lim->nb_phases = 0;
+    for (int k = 0; k < K; k++) {
+        int d = periodes[lim->absorption->classes_persistantes[k]];
+        lim->periode_classe[k] = (d > 1) ? d : 1;
+        lim->decalage[k] = (d > 1) ? lim->nb_phases : -1;
+        if (d > 1) {
+            lim->nb_phases += d;
+            lim->periode = ppcm(lim->periode, d);
+        }
+    }
+    lim->phase = NULL;
+    if (lim->nb_phases > 0) calculer_phases(g, partition, lim, epsilon, max_iter);
+
+    free(periodes);
+    free(suivant);
+    free(corresp);
+    return lim;
+}
+
+// Coefficient L[i][j] de la limite (indices C)
+double limite_coefficient(const t_limite *lim, int i, int j) {
+    int k = lim->rang[j];
+    if (k < 0) return 0.0;
+    return lim->absorption->proba[(size_t)i * lim->absorption->nb_persistantes + k] * lim->stationnaire[j];
+}
+
+// Limite sous forme de matrice dense N x N
+t_matrix* limite_matrice(const t_limite *lim) {
+    int n = lim->nb_sommets;
+    t_matrix *L = creer_matrice_valzeros(n, n);
+    if (L == NULL) return NULL;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) L->data[i][j] = limite_coefficient(lim, i, j);
+    }
+    return L;
+}
+
+// Limite de M^(k * periode + r)[i][j] quand k tend vers l'infini (indices C)
+double limite_cyclique(const t_limite *lim, int i, int j, int r) {
+    int k = lim->rang[j];
+    if (k < 0 || lim->decalage[k] < 0) return limite_coefficient(lim, i, j);
+
+    // j n'est visité qu'aux instants où la phase d'entrée plus r donne sa position
+    int d = lim->periode_classe[k];
+    int a = ((lim->position[j] - r) % d + d) % d;
+    return d * lim->stationnaire[j] * lim->phase[(size_t)i * lim->nb_phases + lim->decalage[k] + a];
+}
+
+// Limite cyclique de phase r sous forme de matrice dense N x N
+t_matrix* limite_matrice_cyclique(const t_limite *lim, int r) {
+    int n = lim->nb_sommets;
+    t_matrix *L = creer_matrice_valzeros(n, n);
+    if (L == NULL) return NULL;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) L->data[i][j] = limite_cyclique(lim, i, j, r);
+    }
+    return L;
+}
+
+// Libère la mémoire d'une limite
+void liberer_limite(t_limite *lim) {
+    if (lim == NULL) return;
+    liberer_absorption(lim->absorption);
+    free(lim->rang);
+    free(lim->stationnaire);
+    free(lim->periode_classe);
+    free(lim->position);
+    free(lim->decalage);
+    free(lim->phase);
+    free(lim);
+}
@@ -2,7 +2,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "utils.h"
+#include "erreurs.h"
 #include <string.h>
+#include <math.h>
 
 // Crée une cellule
 cell *createCell(int arrivee, float probab) {
@@ -34,20 +36,6 @@ void addCell(liste *l, int arrivee, float probab) {
         l->tail = new_cell;
 }
 
-// Affiche toute les arrêtes d'une liste
-void displayListe(liste l) {
-    cell* current = l.head;
-    if (current == NULL) {
-        printf("Empty list\n");
-        return;
-    }
-    while (current != NULL) {
-        printf("-> %d (%.2f) ", current->sommet_arrivee, current->proba);
-        current = current->suivante;
-    }
-    printf("\n");
-}
-
 // Crée une liste d'adjacence vide (tableau de listes)
 listeAdj createListeAdj(int taille) {
     listeAdj nouv;
@@ -64,110 +52,234 @@ listeAdj createListeAdj(int taille) {
     return nouv;
 }
 
-// Affiche une liste d'adjacence (toutes les listes)
-void displayListeAdj(listeAdj g) {
-    for (int i = 0; i < g.nb_sommets; i++) {
-        printf("Sommet %d: ", i + 1);
-        displayListe(g.tab_liste[i]);
+// Libère toutes les cellules et le tableau de listes
+void liberer_listeAdj(listeAdj *g) {
+    for (int i = 0; i < g->nb_sommets; i++) {
+        cell *current = g->tab_liste[i].head;
+        while (current != NULL) {
+            cell *tmp = current;
+            current = current->suivante;
+            free(tmp);
+        }
     }
+    free(g->tab_liste);
+    g->tab_liste = NULL;
+    g->nb_sommets = 0;
 }
 
-// lit un graphe depuis un fichier texte
-listeAdj readGraph(const char *filename) {
+// Somme compensée (Kahan-Babuška) : somme + compensation garde les bits perdus par chaque addition
+static inline void ajouter_compense(double *somme, double *compensation, double x) {
+    double t = *somme + x;
+    if (fabs(*somme) >= fabs(x)) *compensation += (*somme - t) + x;
+    else *compensation += (x - t) + *somme;
+    *somme = t;
+}
+
+// Initialise les paramètres d'une validation (le rapport est rempli par lireGrapheValide)
+void validation_init(t_validation *v, double tolerance, int renormaliser) {
+    memset(v, 0, sizeof(t_validation));
+    v->tolerance = tolerance;
+    v->renormaliser = renormaliser;
+    v->markov = 1;
+}
+
+// Bilan des sommes accumulées pendant la lecture : seules les lignes à renormaliser sont reparcourues
+static void conclure_validation(listeAdj *g, const double *somme, const double *compensation, t_validation *v) {
+    v->nb_invalides = 0;
+    v->nb_signales = 0;
+    v->nb_renormalisees = 0;
+    v->ecart_max = 0.0;
+    v->markov = 1;
+    for (int i = 0; i < g->nb_sommets; i++) {
+        double total = somme[i] + compensation[i];
+        double ecart = fabs(total - 1.0);
+        if (ecart > v->ecart_max) v->ecart_max = ecart;
+        int invalide = ecart > v->tolerance;
+        if (invalide) {
+            if (v->nb_signales < VALIDATION_MAX_SIGNALES) {
+                v->signales[v->nb_signales] = i + 1;
+                v->sommes[v->nb_signales] = total;
+                v->nb_signales++;
+            }
+            v->nb_invalides++;
+        }
+        if (v->renormaliser && total > 0.0 && total != 1.0) {
+            for (cell *c = g->tab_liste[i].head; c != NULL; c = c->suivante) {
+                c->proba = (float)(c->proba / total);
+            }
+            v->nb_renormalisees++;
+        } else if (invalide) {
+            v->markov = 0;
+        }
+    }
+}
+
+// lit un graphe depuis un fichier texte, renvoie MARKOV_OK ou un code d'erreur (g est alors vide)
+int lireGraphe(const char *filename, listeAdj *g) {
+    return lireGrapheValide(filename, g, NULL);
+}
+
+//Fonction qui lit un graphe et le valide dans le même passage : la somme sortante de chaque sommet est
+//accumulée (en double, compensée) à la lecture de ses arêtes. Avec v == NULL, lecture seule.
+//Une chaîne lue mais invalide renvoie MARKOV_OK : le verdict et les sommets fautifs sont dans v
+int lireGrapheValide(const char *filename, listeAdj *g, t_validation *v) {
     FILE *file = fopen(filename, "rt");
     int nbvert, depart, arrivee;
     float proba;
 
+    g->tab_liste = NULL;
+    g->nb_sommets = 0;
     if (file == NULL) {
-        perror("Could not open file for reading");
-        exit(EXIT_FAILURE);
+        return MARKOV_ERR_FICHIER;
     }
 
     //Lecture du nombre de sommets
-    if (fscanf(file, "%d", &nbvert) != 1) {
-        perror("Could not read number of vertices");
-        exit(EXIT_FAILURE);
+    if (fscanf(file, "%d", &nbvert) != 1 || nbvert <= 0) {
+        fclose(file);
+        return MARKOV_ERR_FORMAT;
     }
 
     //Création d'une liste d'adjacence vide
-    listeAdj g = createListeAdj(nbvert);
+    *g = createListeAdj(nbvert);
+    double *somme = NULL, *compensation = NULL;
+    if (v != NULL) {
+        somme = calloc(nbvert, sizeof(double));
+        compensation = calloc(nbvert, sizeof(double));
+    }
+    if (g->tab_liste == NULL || (v != NULL && (somme == NULL || compensation == NULL))) {
+        fclose(file);
+        free(somme);
+        free(compensation);
+        if (g->tab_liste != NULL) liberer_listeAdj(g);
+        g->nb_sommets = 0;
+        return MARKOV_ERR_MEMOIRE;
+    }
 
     while (fscanf(file, "%d %d %f", &depart, &arrivee, &proba) == 3) {
+        // Arête vers ou depuis un sommet qui n'existe pas
+        if (depart < 1 || depart > nbvert || arrivee < 1 || arrivee > nbvert) {
+            fclose(file);
+            free(somme);
+            free(compensation);
+            liberer_listeAdj(g);
+            return MARKOV_ERR_FORMAT;
+        }
         // REMETTRE l'ordre ORIGINAL
-        addCell(&g.tab_liste[depart - 1], arrivee, proba);
+        addCell(&g->tab_liste[depart - 1], arrivee, proba);
+        if (v != NULL) ajouter_compense(&somme[depart - 1], &compensation[depart - 1], proba);
     }
 
     fclose(file);
+    if (v != NULL) conclure_validation(g, somme, compensation, v);
+    free(somme);
+    free(compensation);
+    return MARKOV_OK;
+}
+
+// lit un graphe depuis un fichier texte (graphe vide, sans sommet, en cas d'erreur)
+listeAdj readGraph(const char *filename) {
+    listeAdj g;
+    lireGraphe(filename, &g);
     return g;
 }
 
-// Fonction pour vérifier si le graphe est un graphe de Markov
-int verifierGrapheMarkov(listeAdj g) {
-    int estMarkov = 1;
+// écrit un graphe dans un fichier texte (même format que readGraph), renvoie 0 si tout s'est bien passé
+int ecrireGraphe(listeAdj g, const char *filename) {
+    t_tampon *file = ouvrir_tampon(filename, 0);
+    if (file == NULL) {
+        return -1;
+    }
 
-    //On vérifie chaque sommet
-    for (int i = 0; i < g.nb_sommets; i++) {
-        float somme = 0.0;
-        cell *current = g.tab_liste[i].head;
+    char ligne[64];
+    int len = snprintf(ligne, sizeof(ligne), "%d\n", g.nb_sommets);
+    tampon_ecrire(file, ligne, len);
 
-        // On calcule la somme des probabilités sortantes pour le sommet i
-        while (current != NULL) {
-            somme += current->proba;
-            current = current->suivante;
+    // Les listes sont parcourues à l'envers pour que readGraph (ajout en tête) retrouve le même ordre
+    cell **pile = NULL;
+    int capacite = 0;
+    for (int i = 0; i < g.nb_sommets; i++) {
+        int nb = 0;
+        for (cell *c = g.tab_liste[i].head; c != NULL; c = c->suivante) {
+            if (nb >= capacite) {
+                capacite = capacite ? 2 * capacite : 16;
+                pile = realloc(pile, capacite * sizeof(cell*));
+            }
+            pile[nb++] = c;
         }
-
-        // Vérifier si la somme est environ égale à 1
-        if (somme < 0.99 || somme > 1.00) {
-            printf("la somme des probabilites du sommet %d est %.6f\n", i + 1, somme);
-            estMarkov = 0;
+        while (nb > 0) {
+            cell *c = pile[--nb];
+            len = snprintf(ligne, sizeof(ligne), "%d %d %.9g\n", i + 1, c->sommet_arrivee, c->proba);
+            tampon_ecrire(file, ligne, len);
         }
     }
+    free(pile);
+
+    return fermer_tampon(file);
+}
 
-    // Affiche le résultat final UNE SEULE FOIS
-    if (estMarkov) {
-        printf("Le graphe est un graphe de Markov\n");
-    } else {
-        printf("Le graphe n'est pas un graphe de Markov\n");
+// Somme des probabilités sortantes d'une liste (en double, compensée)
+double sommeSortante(liste l) {
+    double somme = 0.0, compensation = 0.0;
+    for (cell *current = l.head; current != NULL; current = current->suivante) {
+        ajouter_compense(&somme, &compensation, current->proba);
     }
+    return somme + compensation;
+}
 
-    return estMarkov;
+// Fonction pour vérifier si le graphe est un graphe de Markov (graphe déjà en mémoire ;
+// à la lecture d'un fichier, lireGrapheValide fait la même vérification sans second parcours)
+int verifierGrapheMarkov(listeAdj g) {
+    //On vérifie chaque sommet : la somme doit être égale à 1, à TOLERANCE_MARKOV près
+    for (int i = 0; i < g.nb_sommets; i++) {
+        if (fabs(sommeSortante(g.tab_liste[i]) - 1.0) > TOLERANCE_MARKOV) {
+            return 0;
+        }
+    }
+    return 1;
 }
 
 
-// Fonction pour generer le fichier mermaid.txt
-void genererFichierMermaid(listeAdj g, const char* nomFichier) {
-    FILE *file = fopen(nomFichier, "w");
+// Fonction pour generer le fichier mermaid.txt (MARKOV_ERR_FICHIER si le fichier ne peut pas être écrit)
+int genererFichierMermaid(listeAdj g, const char* nomFichier) {
+    t_tampon *file = ouvrir_tampon(nomFichier, 0);
     if (!file) {
-        perror("Impossible de creer le fichier");
-        return;
+        return MARKOV_ERR_FICHIER;
     }
 
     // En-tête demandé par le sujet
-    fprintf(file, "---\n");
-    fprintf(file, "config:\n");
-    fprintf(file, "  layout: elk\n");
-    fprintf(file, "  theme: neo\n");
-    fprintf(file, "  look: neo\n");
-    fprintf(file, "---\n");
-    fprintf(file, "flowchart LR\n");
+    tampon_chaine(file, "---\n"
+                        "config:\n"
+                        "  layout: elk\n"
+                        "  theme: neo\n"
+                        "  look: neo\n"
+                        "---\n"
+                        "flowchart LR\n");
 
     // Déclaration des sommets (avec leur numéro)
     for (int i = 0; i < g.nb_sommets; i++) {
-        fprintf(file, "%s((%d))\n", getID(i + 1), i + 1);
+        tampon_id(file, i + 1);
+        tampon_ecrire(file, "((", 2);
+        tampon_entier(file, i + 1);
+        tampon_ecrire(file, "))\n", 3);
     }
 
     // Déclaration des arêtes (avec leur probabilité)
     for (int i = 0; i < g.nb_sommets; i++) {
+        // L'identifiant du sommet de départ est formaté une seule fois dans un buffer local
+        char id_depart[TAILLE_ID];
+        int len_depart = formaterID(i + 1, id_depart);
+
         cell* current = g.tab_liste[i].head;
         while (current != NULL) {
-            // Pas besoin de free car getID utilise un buffer statique
-            fprintf(file, "%s -->|%.2f|%s\n",
-                    getID(i + 1),
-                    current->proba,
-                    getID(current->sommet_arrivee));
+            tampon_ecrire(file, id_depart, len_depart);
+            tampon_ecrire(file, " -->|", 5);
+            tampon_proba(file, current->proba);
+            tampon_ecrire(file, "|", 1);
+            tampon_id(file, current->sommet_arrivee);
+            tampon_ecrire(file, "\n", 1);
             current = current->suivante;
         }
     }
 
-    fclose(file);
-}
\ No newline at end of file
+    return (fermer_tampon(file) == 0) ? MARKOV_OK : MARKOV_ERR_FICHIER;
+}
@@ -3,10 +3,20 @@
 #include <dirent.h>
 #include <string.h>
 #include <math.h>
+#include <time.h>
 #include "list.h"
 #include "hasse.h"
 #include "tarjan.h"
 #include "matrix.h"
+#include "absorption.h"
+#include "limite.h"
+#include "cli.h"
+#include "affichage.h"
+#include "erreurs.h"
+#include "analyse_classes.h"
+
+// Nombre maximal de limites cycliques affichées pour une chaîne périodique (une matrice N x N par phase)
+#define PHASES_AFFICHEES 8
 
 // Fonction pour afficher tous les fichiers .txt du répertoire
 void afficherFichiersDisponibles() {
@@ -52,7 +62,8 @@ void afficherFichiersDisponibles() {
     }
 }
 
-int main() {
+// Mode interactif : choix du fichier et des paramètres au clavier
+int mode_interactif() {
     // Afficher d'abord tous les fichiers disponibles
     afficherFichiersDisponibles();
 
@@ -88,7 +99,14 @@ int main() {
     }
     fclose(test);
 
-    listeAdj g = readGraph(filename);
+    listeAdj g;
+    t_validation validation;
+    validation_init(&validation, TOLERANCE_MARKOV, 0);
+    int code = lireGrapheValide(filename, &g, &validation);
+    if (code != MARKOV_OK) {
+        printf("\nERREUR : '%s' : %s\n", filename, markov_message_erreur(code));
+        return 1;
+    }
 
     // Affiche la liste adjacente
     printf("Liste Adjacente du graphe :\n");
@@ -97,17 +115,21 @@ int main() {
 
     // Affiche la vérification du graphe de Markov
     printf("Verification graphe de Markov :\n");
-    verifierGrapheMarkov(g);
+    afficherVerificationMarkov(&validation);
     printf("\n");
 
     // Affiche le fichier Mermaid original
     char mermaidFile[150];
     sprintf(mermaidFile, "../data/%s_mermaid.txt", input);
-    genererFichierMermaid(g, mermaidFile);
+    int ecriture = genererFichierMermaid(g, mermaidFile);
+    if (ecriture != MARKOV_OK) {
+        printf("ERREUR : '%s' : %s\n", mermaidFile, markov_message_erreur(ecriture));
+    }
 
     // On commence la partie 2 - Algorithme de tarjan + diagramme de hasse
     // Affiche l'algo de tarjan
     t_partition *partition = tarjan_calculer_partition(g);
+    afficher_composantes(partition);
     printf("\n");
 
     printf("Diagramme de Hasse :\n");
@@ -124,10 +146,19 @@ int main() {
     analyserCarac(partition, &g);
     printf("\n");
 
+    // Où finit la masse des états transitoires et en combien de pas
+    t_absorption *absorption = calculer_absorption(&g, partition, 1e-10, 10000);
+    afficher_absorption(absorption, partition);
+    liberer_absorption(absorption);
+    printf("\n");
+
     // Génère le diagramme de Hasse
     char hasseFile[150];
     sprintf(hasseFile, "../data/%s_hasse.txt", input);
-    genererHasseMermaid(partition, liens, hasseFile, 0);
+    ecriture = genererHasseMermaid(partition, liens, hasseFile, 0);
+    if (ecriture != MARKOV_OK) {
+        printf("ERREUR : '%s' : %s\n", hasseFile, markov_message_erreur(ecriture));
+    }
 
     // On commence la partie 3 - le calcul matriciel
     printf("=========================================================\n");
@@ -462,54 +493,19 @@ int main() {
     printf("Convergence\n");
     printf("============================================\n");
 
-    // Convergence M^k
-    printf("Convergence (epsilon = 0.01)\n");
-
-    t_matrix* Mk = creer_matrice_valzeros(g.nb_sommets, g.nb_sommets);
-    t_matrix* Mk_prev = creer_matrice_valzeros(g.nb_sommets, g.nb_sommets);
-    t_matrix* temp = NULL;
-
-    // Initialiser Mk avec M
-    copie_matrice(M, Mk);
-
-    int iterations = 0;
-    double diff;
-    double epsilon = 0.01;
-    int convergence_atteinte = 0;
-
-    printf("Iterations de convergence :\n");
-    do {
-        copie_matrice(Mk, Mk_prev);  // Sauvegarder précédent
-
-        // Calculer Mk * M
-        temp = multiplication_matrice(Mk, M);
-        if (temp == NULL) {
-            printf("Erreur dans la multiplication matricielle\n");
-            break;
-        }
-        liberer_matrice(Mk);
-        Mk = temp;
-        temp = NULL;
-
-        diff = difference_matrix(Mk, Mk_prev);
-        iterations++;
-
-        printf("Iteration %d: difference = %.6f", iterations, diff);
-        if (diff <= epsilon) {
-            printf(" (convergence atteinte)\n");
-            convergence_atteinte = 1;
-        } else {
-            printf("\n");
-        }
-        // Limite de sécurité
-        if (iterations >= 1000) {
-            printf("Limite d'iterations atteinte\n");
-            break;
-        }
-
-    } while (diff > epsilon);
+    // Limite de M^k calculée par classes (lois stationnaires des classes persistantes,
+    // absorption des transitoires) : aucune puissance de la matrice dense
+    t_limite *limite = calculer_limite(&g, partition, 1e-10, 10000);
+    int pas = limite->periode;
+    if (pas > 1) {
+        printf("Chaine periodique (periode %d) : M^k ne converge pas, limites cycliques de M^(%dk + r)\n", pas, pas);
+    }
     printf("\n");
 
+    // Analyse des classes (période, loi stationnaire, statistiques) sur tous les processeurs,
+    // puis affichage dans l'ordre des classes
+    t_analyse_classes* analyses = analyser_classes(&g, partition, 1e-10, 10000, 0);
+
     // Usage de subMatrix pour toutes les classes
     printf("Sous matrice par classe\n");
     for (int compo_index = 0; compo_index < partition->taille; compo_index++) {
@@ -523,17 +519,16 @@ int main() {
         }
         printf("}\n");
 
-        // 1. Sous-matrice carrée pour calcul de période
-        t_matrix* square_sub_matrice = extractSquareSubMatrix(M, partition, compo_index);
-
-        if (square_sub_matrice != NULL) {
+        // 1. Sous-matrice carrée pour calcul de période (vue sur M, sans copie)
+        t_vue_matrice vue_carree;
+        if (vue_sous_matrice_carree(M, partition, compo_index, &vue_carree) == MARKOV_OK) {
             printf("Sous-matrice CARREE %dx%d (pour calcul de periode):\n",
-                   square_sub_matrice->lignes, square_sub_matrice->cols);
-            afficher_matrice(square_sub_matrice);
+                   vue_carree.nb_lignes, vue_carree.nb_cols);
+            afficher_vue(&vue_carree);
 
             // Calcul de la période
             printf("Calcul de la periode pour cette classe...\n");
-            int period = getPeriod(square_sub_matrice);
+            int period = (analyses != NULL) ? analyses->classes[compo_index].periode : vue_periode(&vue_carree);
             if (period >= 0) {
                 printf("Periode de la classe C%d : %d\n", compo_index + 1, period);
 
@@ -546,44 +541,69 @@ int main() {
             } else {
                 printf("Erreur dans le calcul de la periode\n");
             }
+        }
 
-            liberer_matrice(square_sub_matrice);
+        // Statistiques de la classe et loi stationnaire si elle est persistante
+        if (analyses != NULL) {
+            t_analyse_classe* analyse = &analyses->classes[compo_index];
+            printf("Aretes internes : %lld, aretes sortantes : %lld\n",
+                   analyse->aretes_internes, analyse->aretes_sortantes);
+            printf("Masse moyenne restant dans la classe en un pas : %.4f\n", analyse->masse_interne);
+            if (analyse->persistante) {
+                printf("Classe C%d PERSISTANTE, loi stationnaire (%d iterations, ecart %.2e) :\n",
+                       compo_index + 1, analyse->iterations, analyse->residu);
+                for (int j = 0; j < classe->taille; j++) {
+                    printf("  Etat %d : %.6f\n", classe->sommets[j], analyse->stationnaire[j]);
+                }
+            } else {
+                printf("Classe C%d TRANSITOIRE (masse sortante maximale d'un etat : %.4f)\n",
+                       compo_index + 1, analyse->masse_sortante_max);
+            }
         }
 
         // 2. Sous-matrice originale (toutes lignes, colonnes de la classe)
-        t_matrix* sous_matrice = subMatrix(M, partition, compo_index);
-        if (sous_matrice != NULL) {
+        t_vue_matrice vue_colonnes;
+        if (vue_sous_matrice(M, partition, compo_index, &vue_colonnes) == MARKOV_OK) {
             printf("Sous-matrice ORIGINALE %dx%d (toutes lignes, colonnes de la classe):\n",
-                   sous_matrice->lignes, sous_matrice->cols);
-            afficher_matrice(sous_matrice);
-            liberer_matrice(sous_matrice);
+                   vue_colonnes.nb_lignes, vue_colonnes.nb_cols);
+            afficher_vue(&vue_colonnes);
         }
     }
     printf("\n");
 
     // Résultats convergence
-    if (convergence_atteinte) {
-        printf("Convergence atteinte apres %d iterations\n", iterations);
-        printf("Difference finale : %.6f <= epsilon = %.3f\n", diff, epsilon);
-        printf("Matrice stationnaire M^%d:\n", iterations);
-        afficher_matrice(Mk);
-
-        // Sous-matrices de la matrice stationnaire
-        printf("Sous matrice stationnaire\n");
-        for (int compo_index = 0; compo_index < partition->taille; compo_index++) {
-            printf("Classe C%d (stationnaire) \n", compo_index + 1);
-            t_matrix* sous_matrice_stationnaire = subMatrix(Mk, partition, compo_index);
-
-            if (sous_matrice_stationnaire != NULL) {
-                afficher_matrice(sous_matrice_stationnaire);
-                liberer_matrice(sous_matrice_stationnaire);
-            }
-        }
+    printf("Limite calculee par classes : %d iterations, residu %.2e\n", limite->iterations, limite->residu);
+    t_matrix* L = limite_matrice(limite);
+    if (pas > 1) {
+        // Moyenne des M^(kd + r) sur une période : limite de Cesàro de M^k
+        printf("Limite de Cesaro (moyenne sur une periode) :\n");
     } else {
-        printf("Convergence non atteinte apres %d iterations\n", iterations);
-        printf("Difference finale : %.6f > epsilon = %.3f\n", diff, epsilon);
+        printf("Matrice stationnaire lim M^k :\n");
+    }
+    afficher_matrice(L);
+
+    // Chaîne périodique : M^(kd + r) converge pour chaque phase r (limites lues dans t_limite)
+    for (int r = 0; pas > 1 && r < pas && r < PHASES_AFFICHEES; r++) {
+        t_matrix* Lr = limite_matrice_cyclique(limite, r);
+        printf("Limite de M^(%dk + %d) :\n", pas, r);
+        afficher_matrice(Lr);
+        liberer_matrice(Lr);
+    }
+    if (pas > PHASES_AFFICHEES) {
+        printf("(%d autres phases non affichees)\n", pas - PHASES_AFFICHEES);
     }
 
+    // Sous-matrices de la matrice stationnaire
+    printf("Sous matrice stationnaire\n");
+    for (int compo_index = 0; compo_index < partition->taille; compo_index++) {
+        printf("Classe C%d (stationnaire) \n", compo_index + 1);
+        t_vue_matrice vue_stationnaire;
+        if (vue_sous_matrice(L, partition, compo_index, &vue_stationnaire) == MARKOV_OK) {
+            afficher_vue(&vue_stationnaire);
+        }
+    }
+    liberer_matrice(L);
+
     // Nettoyage mémoire
     for (int i = 0; i < g.nb_sommets; i++) {
         cell *current = g.tab_liste[i].head;
@@ -601,13 +621,23 @@ int main() {
     free(liens);
 
     // Liberation des matrices
-    if (temp != NULL) {
-        liberer_matrice(temp);
-    }
-
-    liberer_matrice(Mk);
-    liberer_matrice(Mk_prev);
     liberer_matrice(M);
+    liberer_limite(limite);
+    liberer_analyse_classes(analyses);
 
     return 0;
-}
\ No newline at end of file
+}
+
+int main(int argc, char **argv) {
+    // Sans argument : mode interactif habituel
+    if (argc < 2) {
+        return mode_interactif();
+    }
+
+    t_options opt;
+    int etat = parser_options(argc, argv, &opt);
+    if (etat != 0) {
+        return (etat > 0) ? 0 : 1;
+    }
+    return executer_cli(&opt);
+}
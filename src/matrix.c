@@ -4,8 +4,7 @@
 #include <math.h>
 #include "list.h"
 #include "tarjan.h"
-
-struct listeAdj* g; //Indispensable si l'on veut travailler avec les listes adjacentes après
+#include "erreurs.h"
 
 //fonction permettant de mettre en place les matrices avec des listes d'adjacences
 t_matrix* creer_matrice_liste_adjacence(listeAdj* g) {
@@ -47,31 +46,23 @@ t_matrix* creer_matrice_valzeros(int lignes, int cols){
   return matrice;
 }
 
-//Fonction permettant de copier la matrice
-void copie_matrice(t_matrix* src, t_matrix* dest){
+//Fonction permettant de copier la matrice, renvoie MARKOV_ERR_DIMENSIONS si les tailles diffèrent
+int copie_matrice(t_matrix* src, t_matrix* dest){
   if (src->lignes != dest->lignes || src->cols != dest->cols) {
-    printf("Attention : Matrice de taille différentes\n");
-    return;
+    return MARKOV_ERR_DIMENSIONS;
     }
     for (int i = 0; i < src->lignes; i++) {
       for (int j = 0; j < src->cols; j++) {
         dest->data[i][j] = src->data[i][j]; // Copie de la matrice source à la matrice destination
       }
   }
+    return MARKOV_OK;
 }
 
 //Fonction permettant de multiplier deux matrices
 t_matrix* multiplication_matrice(t_matrix* M, t_matrix* N){
-    if (M == NULL || N == NULL) {
-        printf("Erreur: Une des matrices est NULL\n");
-        return NULL;
-    }
-
-    if (M->cols != N->lignes) {
-        printf("Erreur de dimensions: impossible de multiplier (%dx%d) par (%dx%d)\n",
-               M->lignes, M->cols, N->lignes, N->cols);
-        printf("Le nombre de colonnes de la premiere (%d) doit etre egal au nombre de lignes de la seconde (%d)\n",
-               M->cols, N->lignes);
+    // Matrice absente ou dimensions incompatibles (colonnes de M != lignes de N)
+    if (M == NULL || N == NULL || M->cols != N->lignes) {
         return NULL;
     }
 
@@ -95,7 +86,6 @@ t_matrix* multiplication_matrice(t_matrix* M, t_matrix* N){
 //Fonction qui calcul la somme des différences absolues
 double difference_matrix(t_matrix* M, t_matrix* N){
   if (M->lignes != N->lignes || M->cols != N->cols) {
-        printf("Attention: Matrices de tailles différentes\n");
         return -1.0;
     }
 
@@ -109,20 +99,32 @@ double difference_matrix(t_matrix* M, t_matrix* N){
     return difference;
 }
 
-//Fonction pour afficher la matrice
-void afficher_matrice(t_matrix* matrice) {
-    for (int i = 0; i < matrice->lignes; i++) {
-        for (int j = 0; j < matrice->cols; j++) {
-            printf("%.2f\t", matrice->data[i][j]);
+//Fonction qui calcule M^k jusqu'à ce que deux puissances successives différent de moins de epsilon
+t_matrix* converger_puissances(t_matrix* M, double epsilon, int max_iter, int *iterations, double *difference) {
+    t_matrix* Mk = creer_matrice_valzeros(M->lignes, M->cols);
+    copie_matrice(M, Mk);
+
+    int iter = 0;
+    double diff = 0.0;
+    do {
+        t_matrix* temp = multiplication_matrice(Mk, M);
+        if (temp == NULL) {
+            break;
         }
-        printf("\n");
-    }
+        diff = difference_matrix(temp, Mk);
+        liberer_matrice(Mk);
+        Mk = temp;
+        iter++;
+    } while (diff > epsilon && iter < max_iter);
+
+    *iterations = iter;
+    *difference = diff;
+    return Mk;
 }
 
 // Fonction qui permet de libérer de la memoire a notre matrice subMatrix
 void liberer_matrice(t_matrix* matrice) {
     if (matrice == NULL) {
-        printf("Tentative de liberation d'une matrice NULL\n");
         return;
     }
 
@@ -137,36 +139,13 @@ void liberer_matrice(t_matrix* matrice) {
 }
 
 //Fonction extrait de la matrice originale uniquement les colonnes correspondant aux sommets d’une classe.
+//La matrice renvoyée est une copie : les calculs qui n'ont pas besoin d'une copie lisent vue_sous_matrice
 t_matrix* subMatrix(t_matrix* matrix, t_partition* part, int compo_index) {
-    // Vérifications de sécurité
-    if (matrix == NULL || part == NULL || compo_index < 0 || compo_index >= part->taille) {
-        printf("Erreur: Paramètres invalides\n");
+    t_vue_matrice vue;
+    if (vue_sous_matrice(matrix, part, compo_index, &vue) != MARKOV_OK) {
         return NULL;
     }
-
-    t_classe* classe = &part->classes[compo_index];
-
-    // Créer une sous-matrice avec les lignes originales, mais seulement les colonnes de la classe
-    t_matrix* result = creer_matrice_valzeros(matrix->lignes, classe->taille);
-
-    // Remplir la sous-matrice
-    for (int i = 0; i < matrix->lignes; i++) {           // Toutes les lignes originales
-        for (int j_classe = 0; j_classe < classe->taille; j_classe++) {  // Seulement les colonnes de la classe
-            int j_matrix = classe->sommets[j_classe] - 1;    // -1 pour convertir en indices C (1-based → 0-based)
-
-            // Vérifier l'indice de colonne
-            if (j_matrix < 0 || j_matrix >= matrix->cols) {
-                printf("Erreur: Indice de colonne %d invalide (après conversion: %d)\n",
-                       classe->sommets[j_classe], j_matrix);
-                liberer_matrice(result);
-                return NULL;
-            }
-            // Copier l'élément
-            result->data[i][j_classe] = matrix->data[i][j_matrix];
-        }
-    }
-
-    return result;
+    return vue_copier(&vue);
 }
 
 int gcd(int *vals, int nbvals) {
@@ -241,32 +220,137 @@ int getPeriod(t_matrix* sub_matrix)  // Note: pointer, not struct by value
 }
 
 
-// Extrait une sous-matrice carrée (lignes ET colonnes d'une classe)
+// Extrait une sous-matrice carrée (lignes ET colonnes d'une classe), copie de vue_sous_matrice_carree
 t_matrix* extractSquareSubMatrix(t_matrix* matrix, t_partition* part, int compo_index) {
-    if (matrix == NULL || part == NULL || compo_index < 0 || compo_index >= part->taille) {
-        printf("Erreur: Paramètres invalides\n");
+    t_vue_matrice vue;
+    if (vue_sous_matrice_carree(matrix, part, compo_index, &vue) != MARKOV_OK) {
         return NULL;
     }
+    return vue_copier(&vue);
+}
 
+// Vérifie qu'une classe existe et que ses sommets sont des indices valides de la dimension
+static int verifier_classe(t_partition* part, int compo_index, int dimension) {
+    if (part == NULL || compo_index < 0 || compo_index >= part->taille) {
+        return MARKOV_ERR_PARAMETRE;
+    }
     t_classe* classe = &part->classes[compo_index];
-    int size = classe->taille;
+    for (int j = 0; j < classe->taille; j++) {
+        if (classe->sommets[j] < 1 || classe->sommets[j] > dimension) {
+            return MARKOV_ERR_DIMENSIONS;
+        }
+    }
+    return MARKOV_OK;
+}
 
-    t_matrix* result = creer_matrice_valzeros(size, size);
+//Fonction qui prépare la vue "toutes les lignes, colonnes de la classe" (comme subMatrix, sans copie).
+//Les index de la vue sont les sommets de la classe : la partition doit vivre aussi longtemps que la vue
+int vue_sous_matrice(t_matrix* matrix, t_partition* part, int compo_index, t_vue_matrice *vue) {
+    if (matrix == NULL || vue == NULL) {
+        return MARKOV_ERR_PARAMETRE;
+    }
+    int code = verifier_classe(part, compo_index, matrix->cols);
+    if (code != MARKOV_OK) {
+        return code;
+    }
+    t_classe* classe = &part->classes[compo_index];
+    vue->parent = matrix;
+    vue->lignes = NULL;
+    vue->cols = classe->sommets;
+    vue->nb_lignes = matrix->lignes;
+    vue->nb_cols = classe->taille;
+    vue->base = 1;
+    return MARKOV_OK;
+}
 
-    // Remplir la sous-matrice carrée
-    for (int i = 0; i < size; i++) {
-        int row_idx = classe->sommets[i] - 1;  // -1 pour indice C
-        for (int j = 0; j < size; j++) {
-            int col_idx = classe->sommets[j] - 1;
+//Fonction qui prépare la vue carrée "lignes et colonnes de la classe" (comme extractSquareSubMatrix, sans copie)
+int vue_sous_matrice_carree(t_matrix* matrix, t_partition* part, int compo_index, t_vue_matrice *vue) {
+    if (matrix == NULL || vue == NULL) {
+        return MARKOV_ERR_PARAMETRE;
+    }
+    int dimension = (matrix->lignes < matrix->cols) ? matrix->lignes : matrix->cols;
+    int code = verifier_classe(part, compo_index, dimension);
+    if (code != MARKOV_OK) {
+        return code;
+    }
+    t_classe* classe = &part->classes[compo_index];
+    vue->parent = matrix;
+    vue->lignes = classe->sommets;
+    vue->cols = classe->sommets;
+    vue->nb_lignes = classe->taille;
+    vue->nb_cols = classe->taille;
+    vue->base = 1;
+    return MARKOV_OK;
+}
+
+// Copie explicite d'une vue dans une matrice indépendante
+t_matrix* vue_copier(const t_vue_matrice *vue) {
+    t_matrix* result = creer_matrice_valzeros(vue->nb_lignes, vue->nb_cols);
+    for (int i = 0; i < vue->nb_lignes; i++) {
+        const double *ligne = vue_ligne(vue, i);
+        for (int j = 0; j < vue->nb_cols; j++) {
+            result->data[i][j] = ligne[vue_col(vue, j)];
+        }
+    }
+    return result;
+}
+
+//Fonction qui multiplie une vue par une matrice (V x M) sans copier la vue. Ordre i-k-j : chaque
+//coefficient de la vue est lu une fois et les lignes de M sont parcourues d'un trait (vectorisable)
+t_matrix* multiplication_vue(const t_vue_matrice *vue, t_matrix* M) {
+    if (vue == NULL || M == NULL || vue->nb_cols != M->lignes) {
+        return NULL;
+    }
 
-            if (row_idx >= 0 && row_idx < matrix->lignes &&
-                col_idx >= 0 && col_idx < matrix->cols) {
-                result->data[i][j] = matrix->data[row_idx][col_idx];
+    int *cols = malloc((vue->nb_cols > 0 ? vue->nb_cols : 1) * sizeof(int));
+    for (int k = 0; k < vue->nb_cols; k++) cols[k] = vue_col(vue, k);
+
+    t_matrix* result = creer_matrice_valzeros(vue->nb_lignes, M->cols);
+    for (int i = 0; i < vue->nb_lignes; i++) {
+        const double *ligne = vue_ligne(vue, i);
+        double *restrict res = result->data[i];
+        for (int k = 0; k < vue->nb_cols; k++) {
+            double a = ligne[cols[k]];
+            if (a == 0.0) continue;
+            const double *restrict mk = M->data[k];
+            for (int j = 0; j < M->cols; j++) {
+                res[j] += a * mk[j];
             }
         }
     }
 
+    free(cols);
     return result;
 }
 
+//Fonction qui calcule la période d'une vue carrée comme getPeriod (mêmes puissances, M^(k+1) = M x M^k)
+//en lisant la vue directement : seule la puissance courante est allouée
+int vue_periode(const t_vue_matrice *vue) {
+    int n = vue->nb_lignes;
+    if (n != vue->nb_cols) {
+        return -1;
+    }
+    int *periods = malloc((n > 0 ? n : 1) * sizeof(int));
+    int period_count = 0;
+    t_matrix* power_matrix = vue_copier(vue);
+
+    for (int cpt = 1; cpt <= n; cpt++) {
+        for (int i = 0; i < n; i++) {
+            if (power_matrix->data[i][i] > 0.0) {
+                periods[period_count++] = cpt;
+                break;
+            }
+        }
+
+        // M^(cpt+1) = M^cpt x M, sans la puissance suivante après la dernière vérification
+        if (cpt == n) break;
+        t_matrix* temp_matrix = multiplication_vue(vue, power_matrix);
+        liberer_matrice(power_matrix);
+        power_matrix = temp_matrix;
+    }
 
+    int period = gcd(periods, period_count);
+    liberer_matrice(power_matrix);
+    free(periods);
+    return period;
+}
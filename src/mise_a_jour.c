@@ -0,0 +1,169 @@
+#include "mise_a_jour.h"
+#include <stdlib.h>
+#include <math.h>
+#include "erreurs.h"
+
+// Fraction du résidu de u résolue par une poussée : en dessous de 1, une part reste en u et la
+// correction ne peut pas tourner indéfiniment en phase avec une chaîne (presque) périodique
+#define RELAXATION 0.9
+
+// Cellule de l'arête depart -> arrivee (numéros du fichier), NULL si elle n'existe pas
+static cell* trouver_arete(listeAdj *g, int depart, int arrivee) {
+    for (cell *c = g->tab_liste[depart - 1].head; c != NULL; c = c->suivante) {
+        if (c->sommet_arrivee == arrivee) return c;
+    }
+    return NULL;
+}
+
+// Retire la cellule vers arrivee d'une liste (la queue est mise à jour)
+static void retirer_arete(liste *l, int arrivee) {
+    cell *precedente = NULL;
+    for (cell *c = l->head; c != NULL; precedente = c, c = c->suivante) {
+        if (c->sommet_arrivee != arrivee) continue;
+        if (precedente == NULL) l->head = c->suivante;
+        else precedente->suivante = c->suivante;
+        if (l->tail == c) l->tail = precedente;
+        free(c);
+        return;
+    }
+}
+
+//Fonction qui applique les modifications au graphe. Rien n'est modifié si une modification est invalide
+//(sommet inexistant, probabilité hors de [0, 1], arête modifiée deux fois) ou si une ligne modifiée
+//ne somme plus à 1 (à TOLERANCE_MARKOV près). delta[k] (si non NULL) reçoit la variation de l'arête k
+int appliquer_modifications(listeAdj *g, const t_modification *mods, int nb, double *delta) {
+    int n = g->nb_sommets;
+    for (int k = 0; k < nb; k++) {
+        const t_modification *m = &mods[k];
+        if (m->depart < 1 || m->depart > n || m->arrivee < 1 || m->arrivee > n) return MARKOV_ERR_PARAMETRE;
+        if (!(m->proba >= 0.0 && m->proba <= 1.0)) return MARKOV_ERR_PARAMETRE;
+        for (int l = 0; l < k; l++) {
+            if (mods[l].depart == m->depart && mods[l].arrivee == m->arrivee) return MARKOV_ERR_PARAMETRE;
+        }
+    }
+
+    // Somme de chaque ligne modifiée après les modifications (une fois par ligne)
+    for (int k = 0; k < nb; k++) {
+        int premiere = 1;
+        for (int l = 0; l < k && premiere; l++) premiere = (mods[l].depart != mods[k].depart);
+        if (!premiere) continue;
+        double somme = sommeSortante(g->tab_liste[mods[k].depart - 1]);
+        for (int l = k; l < nb; l++) {
+            if (mods[l].depart != mods[k].depart) continue;
+            cell *c = trouver_arete(g, mods[l].depart, mods[l].arrivee);
+            somme += (float)mods[l].proba - ((c != NULL) ? c->proba : 0.0f);
+        }
+        if (fabs(somme - 1.0) > TOLERANCE_MARKOV) return MARKOV_ERR_PARAMETRE;
+    }
+
+    for (int k = 0; k < nb; k++) {
+        const t_modification *m = &mods[k];
+        cell *c = trouver_arete(g, m->depart, m->arrivee);
+        float ancienne = (c != NULL) ? c->proba : 0.0f;
+        float nouvelle = (float)m->proba;
+        if (delta != NULL) delta[k] = (double)nouvelle - ancienne;
+        if (c != NULL && nouvelle == 0.0f) retirer_arete(&g->tab_liste[m->depart - 1], m->arrivee);
+        else if (c != NULL) c->proba = nouvelle;
+        else if (nouvelle > 0.0f) addCell(&g->tab_liste[m->depart - 1], m->arrivee, nouvelle);
+    }
+    return MARKOV_OK;
+}
+
+// Ajoute v à la file des états à pousser si son résidu dépasse le seuil
+static inline void signaler(int v, const double *r, double seuil, char *en_file, int *file, int n, int *fin, int *taille) {
+    if (en_file[v] || fabs(r[v]) <= seuil) return;
+    en_file[v] = 1;
+    file[*fin] = v;
+    *fin = (*fin + 1) % n;
+    (*taille)++;
+}
+
+//Fonction qui modifie le graphe et met à jour pi, loi stationnaire de la chaîne avant les modifications
+//(chaîne irréductible, somme de pi égale à 1), par poussées locales du résidu jusqu'à ce qu'aucun état
+//ne dépasse le seuil (ou max_poussees poussées, <= 0 : sans limite). Renvoie MARKOV_OK ou un code d'erreur
+int mettre_a_jour_stationnaire(listeAdj *g, double *pi, const t_modification *mods, int nb,
+                               double seuil, long long max_poussees, t_bilan_maj *bilan) {
+    int n = g->nb_sommets;
+    if (pi == NULL || seuil <= 0.0 || n <= 0) return MARKOV_ERR_PARAMETRE;
+
+    double *delta = malloc((nb > 0 ? nb : 1) * sizeof(double));
+    if (delta == NULL) return MARKOV_ERR_MEMOIRE;
+    int code = appliquer_modifications(g, mods, nb, delta);
+    if (code != MARKOV_OK) {
+        free(delta);
+        return code;
+    }
+
+    double *r = calloc(n, sizeof(double));
+    char *en_file = calloc(n, sizeof(char));
+    char *touche = calloc(n, sizeof(char));
+    int *file = malloc(n * sizeof(int));
+    int *touches = malloc(n * sizeof(int));
+
+    // Résidu initial xD : seules les arrivées des arêtes modifiées
+    int nb_touches = 0;
+    int debut = 0, fin = 0, taille = 0;
+    for (int k = 0; k < nb; k++) {
+        int v = mods[k].arrivee - 1;
+        r[v] += pi[mods[k].depart - 1] * delta[k];
+        if (!touche[v]) {
+            touche[v] = 1;
+            touches[nb_touches++] = v;
+        }
+    }
+    for (int k = 0; k < nb_touches; k++) signaler(touches[k], r, seuil, en_file, file, n, &fin, &taille);
+
+    // Poussée sur u : x[u] += RELAXATION * r[u] / (1 - P'[u][u]) (l'équation de u résolue à RELAXATION
+    // près), le résidu passe à ses successeurs et le reste de u est remis dans la file s'il dépasse le seuil
+    double pousse = 0.0;
+    long long nb_poussees = 0, nb_aretes = 0;
+    while (taille > 0 && (max_poussees <= 0 || nb_poussees < max_poussees)) {
+        int u = file[debut];
+        debut = (debut + 1) % n;
+        taille--;
+        en_file[u] = 0;
+
+        double boucle = 0.0;
+        for (cell *c = g->tab_liste[u].head; c != NULL; c = c->suivante) {
+            if (c->sommet_arrivee - 1 == u) boucle += c->proba;
+        }
+        double alpha = (boucle < 1.0) ? RELAXATION * r[u] / (1.0 - boucle) : 0.0;
+        pi[u] += alpha;
+        pousse += alpha;
+        r[u] -= alpha * (1.0 - boucle);
+        for (cell *c = g->tab_liste[u].head; c != NULL; c = c->suivante) {
+            int v = c->sommet_arrivee - 1;
+            if (v == u) continue;
+            r[v] += alpha * c->proba;
+            if (!touche[v]) {
+                touche[v] = 1;
+                touches[nb_touches++] = v;
+            }
+            signaler(v, r, seuil, en_file, file, n, &fin, &taille);
+            nb_aretes++;
+        }
+        signaler(u, r, seuil, en_file, file, n, &fin, &taille);
+        nb_poussees++;
+    }
+
+    // Les poussées ont changé la masse totale (somme des alpha) : une seule remise à l'échelle
+    double residu = 0.0;
+    for (int k = 0; k < nb_touches; k++) residu += fabs(r[touches[k]]);
+    double facteur = 1.0 / (1.0 + pousse);
+    for (int i = 0; i < n; i++) pi[i] *= facteur;
+
+    if (bilan != NULL) {
+        bilan->nb_poussees = nb_poussees;
+        bilan->nb_aretes = nb_aretes;
+        bilan->nb_touches = nb_touches;
+        bilan->residu = residu * facteur;
+    }
+
+    free(touches);
+    free(file);
+    free(touche);
+    free(en_file);
+    free(r);
+    free(delta);
+    return MARKOV_OK;
+}
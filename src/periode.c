@@ -0,0 +1,66 @@
+#include "periode.h"
+#include <stdlib.h>
+#include "hasse.h"
+#include "erreurs.h"
+
+static int pgcd(int a, int b) {
+    if (a < 0) a = -a;
+    if (b < 0) b = -b;
+    while (b != 0) {
+        int r = a % b;
+        a = b;
+        b = r;
+    }
+    return a;
+}
+
+//Fonction qui calcule la période de chaque classe (0 : aucune arête interne, comme getPeriod)
+//et la position cyclique de chaque sommet (position peut être NULL)
+int calculer_periodes(listeAdj *g, t_partition *partition, int *periodes, int *position) {
+    int n = g->nb_sommets;
+    int *corresp = creer_tab_corresp(partition, n);
+    int *niveau = malloc(n * sizeof(int));
+    int *file = malloc(n * sizeof(int));
+    if (corresp == NULL || niveau == NULL || file == NULL) {
+        free(corresp);
+        free(niveau);
+        free(file);
+        return MARKOV_ERR_MEMOIRE;
+    }
+    for (int i = 0; i < n; i++) niveau[i] = -1;
+
+    for (int c = 0; c < partition->taille; c++) {
+        // Parcours en largeur restreint à la classe, depuis son premier sommet
+        int racine = partition->classes[c].sommets[0] - 1;
+        int tete = 0, queue = 0;
+        int d = 0;
+        niveau[racine] = 0;
+        file[queue++] = racine;
+        while (tete < queue) {
+            int u = file[tete++];
+            for (cell *e = g->tab_liste[u].head; e != NULL; e = e->suivante) {
+                int v = e->sommet_arrivee - 1;
+                if (corresp[v] != c) continue;
+                if (niveau[v] < 0) {
+                    niveau[v] = niveau[u] + 1;
+                    file[queue++] = v;
+                } else {
+                    d = pgcd(d, niveau[u] + 1 - niveau[v]);
+                }
+            }
+        }
+        periodes[c] = d;
+
+        if (position != NULL) {
+            for (int k = 0; k < partition->classes[c].taille; k++) {
+                int s = partition->classes[c].sommets[k] - 1;
+                position[s] = (d > 0) ? niveau[s] % d : 0;
+            }
+        }
+    }
+
+    free(corresp);
+    free(niveau);
+    free(file);
+    return MARKOV_OK;
+}
@@ -0,0 +1,189 @@
+#include "propagation.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "alea.h"
+#include "instrum.h"
+#include "reprise.h"
+#include "erreurs.h"
+
+// Un pas de propagation : Y = X * P pour les K scénarios à la fois
+static void propager_une_etape(const t_csr *csr, const double *restrict X, double *restrict Y, int K) {
+    memset(Y, 0, (size_t)csr->nb_sommets * K * sizeof(double));
+
+    for (int i = 0; i < csr->nb_sommets; i++) {
+        const double *restrict xi = X + (size_t)i * K;
+        for (int e = csr->debut[i]; e < csr->debut[i + 1]; e++) {
+            double p = csr->proba[e];
+            double *restrict yj = Y + (size_t)csr->arrivee[e] * K;
+
+            // Boucle sur les scénarios : contiguë et sans dépendance, donc vectorisable
+            for (int k = 0; k < K; k++) {
+                yj[k] += p * xi[k];
+            }
+        }
+    }
+}
+
+// Applique n pas au bloc N x K (rangé sommet par sommet), le résultat est écrit dans bloc
+void propager_bloc(const t_csr *csr, double *bloc, int K, int n) {
+    if (n <= 0 || K <= 0) return;
+
+    double *tampon = malloc((size_t)csr->nb_sommets * K * sizeof(double));
+    double *X = bloc;
+    double *Y = tampon;
+
+    for (int pas = 0; pas < n; pas++) {
+        propager_une_etape(csr, X, Y, K);
+        double *tmp = X;
+        X = Y;
+        Y = tmp;
+    }
+
+    // Après un nombre impair de pas, le résultat est dans le tampon
+    if (X != bloc) {
+        memcpy(bloc, X, (size_t)csr->nb_sommets * K * sizeof(double));
+    }
+    free(tampon);
+}
+
+// Transposition des distributions K x N vers le bloc N x K
+static double* bloc_depuis_matrice(t_matrix *init) {
+    int K = init->lignes;
+    int N = init->cols;
+    double *bloc = malloc((size_t)N * (K > 0 ? K : 1) * sizeof(double));
+    for (int k = 0; k < K; k++) {
+        for (int i = 0; i < N; i++) {
+            bloc[(size_t)i * K + k] = init->data[k][i];
+        }
+    }
+    return bloc;
+}
+
+// Retour au format K x N du reste du projet
+static t_matrix* matrice_depuis_bloc(const double *bloc, int K, int N) {
+    t_matrix *resultat = creer_matrice_valzeros(K, N);
+    for (int i = 0; i < N; i++) {
+        for (int k = 0; k < K; k++) {
+            resultat->data[k][i] = bloc[(size_t)i * K + k];
+        }
+    }
+    return resultat;
+}
+
+//Fonction qui propage K distributions initiales (matrice K x N) sur n transitions
+t_matrix* propager_distributions(listeAdj *g, t_matrix *init, int n) {
+    // Les distributions doivent avoir N colonnes
+    if (init == NULL || init->cols != g->nb_sommets) {
+        return NULL;
+    }
+
+    int K = init->lignes;
+    int N = g->nb_sommets;
+    t_csr *csr = creer_csr(g);
+    double *bloc = bloc_depuis_matrice(init);
+
+    propager_bloc(csr, bloc, K, n);
+
+    t_matrix *resultat = matrice_depuis_bloc(bloc, K, N);
+    free(bloc);
+    liberer_csr(csr);
+    return resultat;
+}
+
+//Fonction qui propage comme propager_distributions sur le graphe compressé : moins d'octets lus
+//par pas, les arêtes sont décodées au fil du parcours
+t_matrix* propager_distributions_compresse(const t_graphe_compresse *gc, t_matrix *init, int n) {
+    if (gc == NULL || init == NULL || init->cols != gc->nb_sommets) {
+        return NULL;
+    }
+
+    int K = init->lignes;
+    int N = gc->nb_sommets;
+    double *X = bloc_depuis_matrice(init);
+    double *Y = malloc((size_t)N * (K > 0 ? K : 1) * sizeof(double));
+
+    for (int pas = 0; pas < n && K > 0; pas++) {
+        compresse_propager_etape(gc, X, Y, K);
+        double *tmp = X;
+        X = Y;
+        Y = tmp;
+    }
+
+    t_matrix *resultat = matrice_depuis_bloc(X, K, N);
+    free(X);
+    free(Y);
+    return resultat;
+}
+
+// Signature d'une propagation : la chaîne et les distributions de départ (pas l'horizon,
+// un point atteint pour n transitions sert aussi à tout horizon plus lointain)
+static unsigned long long signature_propagation(const t_csr *csr, const double *bloc, size_t nb) {
+    unsigned long long h = csr_signature(csr);
+    for (size_t v = 0; v < nb; v++) {
+        unsigned long long bits;
+        memcpy(&bits, &bloc[v], sizeof(bits));
+        h = alea_melanger(h ^ bits);
+    }
+    return alea_melanger(h ^ nb);
+}
+
+//Fonction qui propage comme propager_distributions en écrivant régulièrement un point de reprise,
+//et repart du point du fichier s'il vient du même calcul et n'a pas dépassé n (un point plus avancé
+//est gardé : aucun point n'est écrit)
+t_matrix* propager_distributions_reprise(listeAdj *g, t_matrix *init, int n, t_reprise *reprise) {
+    if (init == NULL || init->cols != g->nb_sommets || reprise == NULL || reprise->fichier == NULL) {
+        return NULL;
+    }
+
+    int K = init->lignes;
+    int N = g->nb_sommets;
+    size_t nb = (size_t)N * K;
+    t_csr *csr = creer_csr(g);
+    double *X = bloc_depuis_matrice(init);
+    double *Y = malloc((nb > 0 ? nb : 1) * sizeof(double));
+    unsigned long long signature = signature_propagation(csr, X, nb);
+
+    reprise->reprise = 0;
+    reprise->points = 0;
+    reprise->code = MARKOV_OK;
+    t_point_reprise point;
+    long long sur_disque = 0;
+    if (reprise_charger(reprise->fichier, signature, nb, &point) == MARKOV_OK) {
+        sur_disque = point.iteration;
+        if (point.iteration <= n) {
+            memcpy(X, point.valeurs, nb * sizeof(double));
+            reprise->reprise = point.iteration;
+        }
+        free(point.valeurs);
+    }
+
+    t_ecrivain_reprise *ecrivain = demarrer_ecrivain_reprise(reprise->fichier, nb);
+    double dernier_point = horloge_monotone();
+    for (long long pas = reprise->reprise; pas < n; pas++) {
+        propager_une_etape(csr, X, Y, K);
+        double *tmp = X;
+        X = Y;
+        Y = tmp;
+
+        // Point intermédiaire, ou point final (il sert de départ aux horizons plus lointains)
+        double maintenant = horloge_monotone();
+        if (ecrivain != NULL && pas + 1 > sur_disque && (pas + 1 == n || maintenant - dernier_point >= reprise->intervalle)) {
+            double residu = 0.0;
+            for (size_t v = 0; v < nb; v++) {
+                double ecart = X[v] > Y[v] ? X[v] - Y[v] : Y[v] - X[v];
+                if (ecart > residu) residu = ecart;
+            }
+            ecrivain_soumettre(ecrivain, signature, pas + 1, residu, X);
+            dernier_point = maintenant;
+        }
+    }
+    if (ecrivain != NULL) reprise->code = arreter_ecrivain_reprise(ecrivain, &reprise->points);
+    else reprise->code = MARKOV_ERR_MEMOIRE;
+
+    t_matrix *resultat = matrice_depuis_bloc(X, K, N);
+    free(X);
+    free(Y);
+    liberer_csr(csr);
+    return resultat;
+}
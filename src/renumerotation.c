@@ -0,0 +1,290 @@
+#include "renumerotation.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hasse.h"
+
+static const char *noms_ordres[ORDRE_NB] = {
+    "origine", "classes", "largeur", "rcm"
+};
+
+// Voisin d'un sommet dans le parcours de Cuthill-McKee, trié par degré croissant
+typedef struct {
+    int degre;
+    int sommet;
+} t_voisin;
+
+static int comparer_voisins(const void *a, const void *b) {
+    const t_voisin *x = a, *y = b;
+    if (x->degre != y->degre) return (x->degre > y->degre) - (x->degre < y->degre);
+    return (x->sommet > y->sommet) - (x->sommet < y->sommet);
+}
+
+const char* nom_ordre(t_ordre ordre) {
+    return (ordre >= 0 && ordre < ORDRE_NB) ? noms_ordres[ordre] : "inconnu";
+}
+
+// Renvoie l'ordre correspondant au nom, -1 s'il est inconnu
+int ordre_depuis_nom(const char *nom) {
+    for (int o = 0; o < ORDRE_NB; o++) {
+        if (strcmp(nom, noms_ordres[o]) == 0) return o;
+    }
+    return -1;
+}
+
+// Classes dans l'ordre topologique : Tarjan les produit puits d'abord, on les reprend à l'envers.
+// Dans une classe, parcours en largeur limité à la classe (voisins proches, numéros proches)
+static void ordre_classes(listeAdj *g, t_partition *partition, int *ancien) {
+    int n = g->nb_sommets;
+    t_partition *p = (partition != NULL) ? partition : tarjan_calculer_partition(*g);
+    int *corresp = creer_tab_corresp(p, n);
+    char *vu = calloc(n > 0 ? n : 1, sizeof(char));
+
+    int fin = 0;
+    for (int c = p->taille - 1; c >= 0; c--) {
+        for (int s = 0; s < p->classes[c].taille; s++) {
+            int depart = p->classes[c].sommets[s] - 1;
+            if (vu[depart]) continue;
+            int tete = fin;
+            ancien[fin++] = depart;
+            vu[depart] = 1;
+            while (tete < fin) {
+                int u = ancien[tete++];
+                for (cell *e = g->tab_liste[u].head; e != NULL; e = e->suivante) {
+                    int v = e->sommet_arrivee - 1;
+                    if (!vu[v] && corresp[v] == c) {
+                        vu[v] = 1;
+                        ancien[fin++] = v;
+                    }
+                }
+            }
+        }
+    }
+
+    free(vu);
+    free(corresp);
+    if (p != partition) liberer_partition(p);
+}
+
+// Parcours en largeur (arêtes sortantes, dans l'ordre des listes)
+static void ordre_largeur(listeAdj *g, int *ancien) {
+    int n = g->nb_sommets;
+    char *vu = calloc(n > 0 ? n : 1, sizeof(char));
+    int fin = 0;
+    for (int s = 0; s < n; s++) {
+        if (vu[s]) continue;
+        int tete = fin;
+        ancien[fin++] = s;
+        vu[s] = 1;
+        while (tete < fin) {
+            int u = ancien[tete++];
+            for (cell *c = g->tab_liste[u].head; c != NULL; c = c->suivante) {
+                int v = c->sommet_arrivee - 1;
+                if (!vu[v]) {
+                    vu[v] = 1;
+                    ancien[fin++] = v;
+                }
+            }
+        }
+    }
+    free(vu);
+}
+
+// Cuthill-McKee inverse : parcours en largeur du graphe symétrisé, voisins par degré croissant,
+// chaque composante démarrant au sommet non visité de plus petit degré ; l'ordre est ensuite renversé
+static void ordre_rcm(listeAdj *g, int *ancien) {
+    int n = g->nb_sommets;
+
+    // Graphe symétrisé au format CSR (les boucles sont ignorées)
+    int *debut = calloc((size_t)n + 1, sizeof(int));
+    for (int i = 0; i < n; i++) {
+        for (cell *c = g->tab_liste[i].head; c != NULL; c = c->suivante) {
+            int j = c->sommet_arrivee - 1;
+            if (j == i) continue;
+            debut[i + 1]++;
+            debut[j + 1]++;
+        }
+    }
+    for (int i = 0; i < n; i++) debut[i + 1] += debut[i];
+    int *voisins = malloc((debut[n] > 0 ? debut[n] : 1) * sizeof(int));
+    int *position = malloc((n > 0 ? n : 1) * sizeof(int));
+    memcpy(position, debut, (n > 0 ? n : 1) * sizeof(int));
+    for (int i = 0; i < n; i++) {
+        for (cell *c = g->tab_liste[i].head; c != NULL; c = c->suivante) {
+            int j = c->sommet_arrivee - 1;
+            if (j == i) continue;
+            voisins[position[i]++] = j;
+            voisins[position[j]++] = i;
+        }
+    }
+
+    // Sommets par degré croissant : premier non visité = départ de la composante suivante
+    t_voisin *par_degre = malloc((n > 0 ? n : 1) * sizeof(t_voisin));
+    for (int i = 0; i < n; i++) {
+        par_degre[i].degre = debut[i + 1] - debut[i];
+        par_degre[i].sommet = i;
+    }
+    qsort(par_degre, n, sizeof(t_voisin), comparer_voisins);
+
+    char *vu = calloc(n > 0 ? n : 1, sizeof(char));
+    int capacite = 16;
+    t_voisin *candidats = malloc(capacite * sizeof(t_voisin));
+    int fin = 0;
+    for (int d = 0; d < n; d++) {
+        int s = par_degre[d].sommet;
+        if (vu[s]) continue;
+        int tete = fin;
+        ancien[fin++] = s;
+        vu[s] = 1;
+        while (tete < fin) {
+            int u = ancien[tete++];
+            int nb = 0;
+            for (int e = debut[u]; e < debut[u + 1]; e++) {
+                int v = voisins[e];
+                if (vu[v]) continue;
+                vu[v] = 1;
+                if (nb >= capacite) {
+                    capacite *= 2;
+                    candidats = realloc(candidats, capacite * sizeof(t_voisin));
+                }
+                candidats[nb].degre = debut[v + 1] - debut[v];
+                candidats[nb].sommet = v;
+                nb++;
+            }
+            qsort(candidats, nb, sizeof(t_voisin), comparer_voisins);
+            for (int k = 0; k < nb; k++) ancien[fin++] = candidats[k].sommet;
+        }
+    }
+
+    for (int a = 0, b = n - 1; a < b; a++, b--) {
+        int tmp = ancien[a];
+        ancien[a] = ancien[b];
+        ancien[b] = tmp;
+    }
+
+    free(candidats);
+    free(vu);
+    free(par_degre);
+    free(position);
+    free(voisins);
+    free(debut);
+}
+
+//Fonction qui calcule la renumérotation des états pour l'ordre demandé. La partition ne sert qu'à
+//l'ordre CLASSES (NULL : calculée ici) ; ORIGINE donne l'identité
+t_permutation* calculer_permutation(listeAdj *g, t_partition *partition, t_ordre ordre) {
+    if (ordre < 0 || ordre >= ORDRE_NB) return NULL;
+
+    int n = g->nb_sommets;
+    t_permutation *perm = malloc(sizeof(t_permutation));
+    perm->nb_sommets = n;
+    perm->ancien = malloc((n > 0 ? n : 1) * sizeof(int));
+    perm->nouveau = malloc((n > 0 ? n : 1) * sizeof(int));
+
+    switch (ordre) {
+    case ORDRE_CLASSES:
+        ordre_classes(g, partition, perm->ancien);
+        break;
+    case ORDRE_LARGEUR:
+        ordre_largeur(g, perm->ancien);
+        break;
+    case ORDRE_RCM:
+        ordre_rcm(g, perm->ancien);
+        break;
+    default:
+        for (int k = 0; k < n; k++) perm->ancien[k] = k;
+        break;
+    }
+
+    for (int k = 0; k < n; k++) perm->nouveau[perm->ancien[k]] = k;
+    return perm;
+}
+
+// Libère la mémoire de la permutation
+void liberer_permutation(t_permutation *perm) {
+    if (perm == NULL) return;
+    free(perm->nouveau);
+    free(perm->ancien);
+    free(perm);
+}
+
+//Fonction qui construit le graphe renuméroté : le sommet k est l'état ancien[k] du fichier.
+//Les listes gardent leur ordre, seuls les numéros d'arrivée changent
+listeAdj permuter_graphe(listeAdj *g, const t_permutation *perm) {
+    int n = g->nb_sommets;
+    listeAdj gp = createListeAdj(n);
+    int degre_max = 0;
+    for (int i = 0; i < n; i++) {
+        int degre = 0;
+        for (cell *c = g->tab_liste[i].head; c != NULL; c = c->suivante) degre++;
+        if (degre > degre_max) degre_max = degre;
+    }
+
+    // addCell ajoute en tête : cellules d'une liste relevées puis ajoutées à l'envers
+    cell **pile = malloc((degre_max > 0 ? degre_max : 1) * sizeof(cell*));
+    for (int k = 0; k < n; k++) {
+        int nb = 0;
+        for (cell *c = g->tab_liste[perm->ancien[k]].head; c != NULL; c = c->suivante) pile[nb++] = c;
+        while (nb > 0) {
+            cell *c = pile[--nb];
+            addCell(&gp.tab_liste[k], perm->nouveau[c->sommet_arrivee - 1] + 1, c->proba);
+        }
+    }
+    free(pile);
+    return gp;
+}
+
+//Fonction qui permute les colonnes d'une matrice K x N (distributions) vers les numéros du graphe
+//renuméroté (PERMUTER) ou revient aux numéros du fichier (RESTAURER). La matrice d'origine est conservée
+t_matrix* permuter_colonnes(t_matrix *m, const t_permutation *perm, int sens) {
+    if (m == NULL || m->cols != perm->nb_sommets) return NULL;
+    t_matrix *resultat = creer_matrice_valzeros(m->lignes, m->cols);
+    for (int k = 0; k < m->lignes; k++) {
+        for (int i = 0; i < m->cols; i++) {
+            if (sens == PERMUTER) resultat->data[k][perm->nouveau[i]] = m->data[k][i];
+            else resultat->data[k][i] = m->data[k][perm->nouveau[i]];
+        }
+    }
+    return resultat;
+}
+
+//Fonction qui permute les lignes et les colonnes d'une matrice N x N (P M P^T), dans le sens demandé
+t_matrix* permuter_matrice(t_matrix *m, const t_permutation *perm, int sens) {
+    int n = perm->nb_sommets;
+    if (m == NULL || m->lignes != n || m->cols != n) return NULL;
+    t_matrix *resultat = creer_matrice_valzeros(n, n);
+    for (int i = 0; i < n; i++) {
+        int pi = perm->nouveau[i];
+        for (int j = 0; j < n; j++) {
+            if (sens == PERMUTER) resultat->data[pi][perm->nouveau[j]] = m->data[i][j];
+            else resultat->data[i][j] = m->data[pi][perm->nouveau[j]];
+        }
+    }
+    return resultat;
+}
+
+// Remet les sommets d'une partition calculée sur le graphe renuméroté aux numéros du fichier
+void restaurer_partition(t_partition *partition, const t_permutation *perm) {
+    for (int c = 0; c < partition->taille; c++) {
+        t_classe *classe = &partition->classes[c];
+        for (int s = 0; s < classe->taille; s++) {
+            classe->sommets[s] = perm->ancien[classe->sommets[s] - 1] + 1;
+        }
+    }
+}
+
+//Fonction qui mesure la localité : écart moyen |i - j| entre les numéros des deux extrémités d'une
+//arête, avec la renumérotation (NULL : numéros du fichier)
+double ecart_moyen(listeAdj *g, const t_permutation *perm) {
+    double somme = 0.0;
+    long long nb = 0;
+    for (int i = 0; i < g->nb_sommets; i++) {
+        int a = (perm != NULL) ? perm->nouveau[i] : i;
+        for (cell *c = g->tab_liste[i].head; c != NULL; c = c->suivante) {
+            int b = (perm != NULL) ? perm->nouveau[c->sommet_arrivee - 1] : c->sommet_arrivee - 1;
+            somme += (a > b) ? a - b : b - a;
+            nb++;
+        }
+    }
+    return (nb > 0) ? somme / nb : 0.0;
+}
@@ -0,0 +1,176 @@
+#include "reprise.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "erreurs.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+
+#define REPRISE_MAGIQUE "MKVREPRI"
+#define REPRISE_VERSION 1
+
+// Remplace chemin par chemin_temporaire. Sous Windows, rename échoue si la destination existe :
+// MoveFileEx la remplace (chaque point de reprise après le premier), renvoie 0 si le remplacement a eu lieu
+static int remplacer_fichier(const char *chemin_temporaire, const char *chemin) {
+#if defined(_WIN32)
+    return MoveFileExA(chemin_temporaire, chemin, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) ? 0 : -1;
+#else
+    return rename(chemin_temporaire, chemin);
+#endif
+}
+
+//Fonction qui écrit un point de reprise (nom temporaire puis renommage)
+int reprise_ecrire(const char *chemin, const char *chemin_temporaire, const t_point_reprise *point) {
+    FILE *f = fopen(chemin_temporaire, "wb");
+    if (f == NULL) return MARKOV_ERR_FICHIER;
+
+    int version = REPRISE_VERSION;
+    unsigned long long nb = point->nb_valeurs;
+    int ok = fwrite(REPRISE_MAGIQUE, 1, 8, f) == 8
+          && fwrite(&version, sizeof(int), 1, f) == 1
+          && fwrite(&point->signature, sizeof(point->signature), 1, f) == 1
+          && fwrite(&point->iteration, sizeof(point->iteration), 1, f) == 1
+          && fwrite(&point->residu, sizeof(point->residu), 1, f) == 1
+          && fwrite(&nb, sizeof(nb), 1, f) == 1
+          && fwrite(point->valeurs, sizeof(double), point->nb_valeurs, f) == point->nb_valeurs;
+
+    if (fclose(f) != 0) ok = 0;
+    if (!ok || remplacer_fichier(chemin_temporaire, chemin) != 0) {
+        remove(chemin_temporaire);
+        return MARKOV_ERR_FICHIER;
+    }
+    return MARKOV_OK;
+}
+
+//Fonction qui relit un point de reprise du même calcul (même signature et même taille d'état)
+//point->valeurs est alloué ici et libéré par l'appelant
+int reprise_charger(const char *chemin, unsigned long long signature, size_t nb_valeurs, t_point_reprise *point) {
+    FILE *f = fopen(chemin, "rb");
+    if (f == NULL) return MARKOV_ERR_FICHIER;
+
+    char magique[8];
+    int version;
+    unsigned long long nb;
+    int ok = fread(magique, 1, 8, f) == 8 && memcmp(magique, REPRISE_MAGIQUE, 8) == 0
+          && fread(&version, sizeof(int), 1, f) == 1 && version == REPRISE_VERSION
+          && fread(&point->signature, sizeof(point->signature), 1, f) == 1
+          && fread(&point->iteration, sizeof(point->iteration), 1, f) == 1
+          && fread(&point->residu, sizeof(point->residu), 1, f) == 1
+          && fread(&nb, sizeof(nb), 1, f) == 1;
+    if (!ok || point->signature != signature || nb != nb_valeurs || point->iteration < 0) {
+        // Point d'un autre calcul, ou fichier tronqué : on repart du début
+        fclose(f);
+        return MARKOV_ERR_FORMAT;
+    }
+
+    point->nb_valeurs = nb_valeurs;
+    point->valeurs = malloc((nb_valeurs > 0 ? nb_valeurs : 1) * sizeof(double));
+    if (point->valeurs == NULL) {
+        fclose(f);
+        return MARKOV_ERR_MEMOIRE;
+    }
+    if (fread(point->valeurs, sizeof(double), nb_valeurs, f) != nb_valeurs) {
+        free(point->valeurs);
+        point->valeurs = NULL;
+        fclose(f);
+        return MARKOV_ERR_FORMAT;
+    }
+    fclose(f);
+    return MARKOV_OK;
+}
+
+// Boucle du thread d'écriture : attend un point, l'écrit hors du verrou, jusqu'à l'arrêt
+static void* thread_ecriture(void *arg) {
+    t_ecrivain_reprise *ecrivain = arg;
+
+    pthread_mutex_lock(&ecrivain->verrou);
+    while (1) {
+        while (!ecrivain->en_attente && !ecrivain->arret) {
+            pthread_cond_wait(&ecrivain->signal, &ecrivain->verrou);
+        }
+        if (!ecrivain->en_attente) break;
+
+        // Échange des tampons : le calcul peut déposer le point suivant pendant l'écriture
+        t_point_reprise tmp = ecrivain->ecriture;
+        ecrivain->ecriture = ecrivain->attente;
+        ecrivain->attente = tmp;
+        ecrivain->en_attente = 0;
+        pthread_mutex_unlock(&ecrivain->verrou);
+
+        int code = reprise_ecrire(ecrivain->chemin, ecrivain->chemin_temporaire, &ecrivain->ecriture);
+
+        pthread_mutex_lock(&ecrivain->verrou);
+        ecrivain->code = code;
+        if (code == MARKOV_OK) ecrivain->ecrits++;
+    }
+    pthread_mutex_unlock(&ecrivain->verrou);
+    return NULL;
+}
+
+//Fonction qui démarre le thread d'écriture des points de reprise (états de nb_valeurs réels)
+t_ecrivain_reprise* demarrer_ecrivain_reprise(const char *chemin, size_t nb_valeurs) {
+    t_ecrivain_reprise *ecrivain = calloc(1, sizeof(t_ecrivain_reprise));
+    if (ecrivain == NULL) return NULL;
+
+    size_t taille = strlen(chemin) + 5;
+    ecrivain->chemin = malloc(taille);
+    ecrivain->chemin_temporaire = malloc(taille);
+    ecrivain->attente.valeurs = malloc((nb_valeurs > 0 ? nb_valeurs : 1) * sizeof(double));
+    ecrivain->ecriture.valeurs = malloc((nb_valeurs > 0 ? nb_valeurs : 1) * sizeof(double));
+    if (ecrivain->chemin == NULL || ecrivain->chemin_temporaire == NULL
+        || ecrivain->attente.valeurs == NULL || ecrivain->ecriture.valeurs == NULL) {
+        free(ecrivain->chemin);
+        free(ecrivain->chemin_temporaire);
+        free(ecrivain->attente.valeurs);
+        free(ecrivain->ecriture.valeurs);
+        free(ecrivain);
+        return NULL;
+    }
+    snprintf(ecrivain->chemin, taille, "%s", chemin);
+    snprintf(ecrivain->chemin_temporaire, taille, "%s.tmp", chemin);
+    ecrivain->attente.nb_valeurs = nb_valeurs;
+    ecrivain->ecriture.nb_valeurs = nb_valeurs;
+    ecrivain->code = MARKOV_OK;
+
+    pthread_mutex_init(&ecrivain->verrou, NULL);
+    pthread_cond_init(&ecrivain->signal, NULL);
+    pthread_create(&ecrivain->thread, NULL, thread_ecriture, ecrivain);
+    return ecrivain;
+}
+
+// Dépose un point à écrire : seule la copie de l'état bloque le calcul
+void ecrivain_soumettre(t_ecrivain_reprise *ecrivain, unsigned long long signature, long long iteration,
+                        double residu, const double *valeurs) {
+    pthread_mutex_lock(&ecrivain->verrou);
+    ecrivain->attente.signature = signature;
+    ecrivain->attente.iteration = iteration;
+    ecrivain->attente.residu = residu;
+    memcpy(ecrivain->attente.valeurs, valeurs, ecrivain->attente.nb_valeurs * sizeof(double));
+    ecrivain->en_attente = 1;
+    pthread_cond_signal(&ecrivain->signal);
+    pthread_mutex_unlock(&ecrivain->verrou);
+}
+
+//Fonction qui écrit le dernier point déposé, arrête le thread et renvoie le code de la dernière écriture
+int arreter_ecrivain_reprise(t_ecrivain_reprise *ecrivain, int *ecrits) {
+    if (ecrivain == NULL) return MARKOV_ERR_PARAMETRE;
+
+    pthread_mutex_lock(&ecrivain->verrou);
+    ecrivain->arret = 1;
+    pthread_cond_signal(&ecrivain->signal);
+    pthread_mutex_unlock(&ecrivain->verrou);
+    pthread_join(ecrivain->thread, NULL);
+
+    int code = ecrivain->code;
+    if (ecrits != NULL) *ecrits = ecrivain->ecrits;
+    pthread_mutex_destroy(&ecrivain->verrou);
+    pthread_cond_destroy(&ecrivain->signal);
+    free(ecrivain->chemin);
+    free(ecrivain->chemin_temporaire);
+    free(ecrivain->attente.valeurs);
+    free(ecrivain->ecriture.valeurs);
+    free(ecrivain);
+    return code;
+}
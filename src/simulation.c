@@ -0,0 +1,225 @@
+#include "simulation.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "alea.h"
+#include "alias.h"
+#include "hasse.h"
+
+// Nombre de marches distribuées à un thread à chaque prise de travail
+#define BLOC_MARCHES 1024
+
+/** Données partagées par les threads de simulation (lecture seule sauf le compteur de blocs)
+**/
+typedef struct {
+    const t_alias *tables;
+    const t_params_simulation *params;
+    const double *cumul_init;     // distribution initiale cumulée (NULL : état fixe)
+    const int *rang_sommet;       // rang de la classe persistante du sommet, -1 si transitoire
+    long long prochain_bloc;
+    pthread_mutex_t verrou;
+} t_contexte_simulation;
+
+// Compteurs propres à un thread, fusionnés à la fin
+typedef struct {
+    t_contexte_simulation *ctx;
+    t_resultat_simulation *local;
+} t_travail_simulation;
+
+// Premier indice i tel que cumul[i] > u (recherche dichotomique)
+static int tirer_depart(const double *cumul, int n, double u) {
+    int bas = 0, haut = n - 1;
+    while (bas < haut) {
+        int milieu = (bas + haut) / 2;
+        if (u < cumul[milieu]) haut = milieu;
+        else bas = milieu + 1;
+    }
+    return bas;
+}
+
+// Simule la marche numéro w et met à jour les compteurs du thread
+static void simuler_une_marche(t_contexte_simulation *ctx, t_resultat_simulation *res, long long w) {
+    const t_params_simulation *p = ctx->params;
+    unsigned long long cle = alea_cle(p->graine, (unsigned long long)w);
+
+    int s = (ctx->cumul_init != NULL)
+            ? tirer_depart(ctx->cumul_init, res->nb_sommets, alea_uniforme(cle, 0))
+            : p->etat_init - 1;
+    int depart = s;
+    res->departs[depart]++;
+    res->visites[s]++;
+
+    int absorbee = (ctx->rang_sommet != NULL && ctx->rang_sommet[s] >= 0);
+    if (absorbee) {
+        res->absorbees_depart[depart]++;
+        res->absorptions[ctx->rang_sommet[s]]++;
+    }
+
+    for (int t = 1; t <= p->nb_pas && !(absorbee && p->arreter_absorption); t++) {
+        s = alias_tirer(ctx->tables, s, alea_uniforme(cle, (unsigned long long)t));
+        res->visites[s]++;
+
+        if (!absorbee && ctx->rang_sommet != NULL && ctx->rang_sommet[s] >= 0) {
+            absorbee = 1;
+            res->absorbees_depart[depart]++;
+            res->somme_temps[depart] += (unsigned long long)t;
+            res->absorptions[ctx->rang_sommet[s]]++;
+        }
+    }
+
+    res->fin[s]++;
+    if (!absorbee) res->nb_non_absorbees++;
+}
+
+// Boucle d'un thread : prend des blocs de marches jusqu'à épuisement
+static void* thread_simulation(void *arg) {
+    t_travail_simulation *travail = arg;
+    t_contexte_simulation *ctx = travail->ctx;
+    long long nb_blocs = (ctx->params->nb_marches + BLOC_MARCHES - 1) / BLOC_MARCHES;
+
+    while (1) {
+        pthread_mutex_lock(&ctx->verrou);
+        long long bloc = ctx->prochain_bloc++;
+        pthread_mutex_unlock(&ctx->verrou);
+        if (bloc >= nb_blocs) break;
+
+        long long debut = bloc * BLOC_MARCHES;
+        long long fin = debut + BLOC_MARCHES;
+        if (fin > ctx->params->nb_marches) fin = ctx->params->nb_marches;
+        for (long long w = debut; w < fin; w++) {
+            simuler_une_marche(ctx, travail->local, w);
+        }
+    }
+    return NULL;
+}
+
+// Alloue un résultat vide. Chaque tableau est suivi d'une ligne de cache vide pour que
+// les compteurs de deux threads ne partagent jamais une ligne (faux partage)
+static t_resultat_simulation* creer_resultat(int n, int nb_persistantes) {
+    const int marge = 64 / sizeof(unsigned long long);
+    t_resultat_simulation *res = calloc(1, sizeof(t_resultat_simulation) + 64);
+    res->nb_sommets = n;
+    res->visites = calloc(n + marge, sizeof(unsigned long long));
+    res->fin = calloc(n + marge, sizeof(unsigned long long));
+    res->departs = calloc(n + marge, sizeof(unsigned long long));
+    res->absorbees_depart = calloc(n + marge, sizeof(unsigned long long));
+    res->somme_temps = calloc(n + marge, sizeof(unsigned long long));
+    res->nb_persistantes = nb_persistantes;
+    res->classes_persistantes = calloc(nb_persistantes > 0 ? nb_persistantes : 1, sizeof(int));
+    res->absorptions = calloc(nb_persistantes + marge, sizeof(unsigned long long));
+    return res;
+}
+
+void params_simulation_par_defaut(t_params_simulation *p) {
+    p->nb_marches = 100000;
+    p->nb_pas = 100;
+    p->nb_threads = 1;
+    p->graine = 42;
+    p->distribution_init = NULL;
+    p->etat_init = 1;
+    p->arreter_absorption = 0;
+}
+
+//Fonction qui simule nb_marches trajectoires indépendantes de la chaîne en parallèle
+t_resultat_simulation* simuler_marches(listeAdj *g, t_partition *partition, const t_params_simulation *p) {
+    int n = g->nb_sommets;
+    if (p->distribution_init == NULL && (p->etat_init < 1 || p->etat_init > n)) {
+        return NULL;
+    }
+
+    t_contexte_simulation ctx;
+    ctx.tables = creer_alias(g);
+    ctx.params = p;
+    ctx.prochain_bloc = 0;
+    ctx.cumul_init = NULL;
+    ctx.rang_sommet = NULL;
+    pthread_mutex_init(&ctx.verrou, NULL);
+
+    // Distribution initiale cumulée, normalisée pour tolérer une somme différente de 1
+    double *cumul = NULL;
+    if (p->distribution_init != NULL) {
+        cumul = malloc(n * sizeof(double));
+        double somme = 0.0;
+        for (int i = 0; i < n; i++) {
+            somme += (p->distribution_init[i] > 0.0) ? p->distribution_init[i] : 0.0;
+            cumul[i] = somme;
+        }
+        for (int i = 0; i < n; i++) cumul[i] = (somme > 0.0) ? cumul[i] / somme : (double)(i + 1) / n;
+        ctx.cumul_init = cumul;
+    }
+
+    // Classes persistantes : rang de chaque sommet
+    int nb_persistantes = 0;
+    int *rang_sommet = NULL;
+    int *classes = NULL;
+    if (partition != NULL) {
+        int *estPersistante = calculer_persistance(partition, g);
+        int *corresp = creer_tab_corresp(partition, n);
+        int *rang_classe = malloc(partition->taille * sizeof(int));
+        classes = malloc((partition->taille > 0 ? partition->taille : 1) * sizeof(int));
+        for (int c = 0; c < partition->taille; c++) {
+            rang_classe[c] = estPersistante[c] ? nb_persistantes : -1;
+            if (estPersistante[c]) classes[nb_persistantes++] = c;
+        }
+        rang_sommet = malloc(n * sizeof(int));
+        for (int i = 0; i < n; i++) rang_sommet[i] = rang_classe[corresp[i]];
+        ctx.rang_sommet = rang_sommet;
+        free(rang_classe);
+        free(corresp);
+        free(estPersistante);
+    }
+
+    // Un jeu de compteurs par thread
+    int nb_threads = (p->nb_threads > 0) ? p->nb_threads : 1;
+    t_travail_simulation *travaux = malloc(nb_threads * sizeof(t_travail_simulation));
+    pthread_t *threads = malloc(nb_threads * sizeof(pthread_t));
+    for (int t = 0; t < nb_threads; t++) {
+        travaux[t].ctx = &ctx;
+        travaux[t].local = creer_resultat(n, nb_persistantes);
+        pthread_create(&threads[t], NULL, thread_simulation, &travaux[t]);
+    }
+
+    // Fusion : des sommes d'entiers, donc un résultat identique quel que soit le nombre de threads
+    t_resultat_simulation *res = creer_resultat(n, nb_persistantes);
+    res->nb_marches = p->nb_marches;
+    res->nb_pas = p->nb_pas;
+    if (nb_persistantes > 0) memcpy(res->classes_persistantes, classes, nb_persistantes * sizeof(int));
+
+    for (int t = 0; t < nb_threads; t++) {
+        pthread_join(threads[t], NULL);
+        t_resultat_simulation *local = travaux[t].local;
+        for (int i = 0; i < n; i++) {
+            res->visites[i] += local->visites[i];
+            res->fin[i] += local->fin[i];
+            res->departs[i] += local->departs[i];
+            res->absorbees_depart[i] += local->absorbees_depart[i];
+            res->somme_temps[i] += local->somme_temps[i];
+        }
+        for (int k = 0; k < nb_persistantes; k++) res->absorptions[k] += local->absorptions[k];
+        res->nb_non_absorbees += local->nb_non_absorbees;
+        liberer_simulation(local);
+    }
+
+    pthread_mutex_destroy(&ctx.verrou);
+    free(threads);
+    free(travaux);
+    free(classes);
+    free(rang_sommet);
+    free(cumul);
+    liberer_alias((t_alias*)ctx.tables);
+    return res;
+}
+
+// Libère la mémoire d'un résultat de simulation
+void liberer_simulation(t_resultat_simulation *res) {
+    if (res == NULL) return;
+    free(res->visites);
+    free(res->fin);
+    free(res->departs);
+    free(res->absorbees_depart);
+    free(res->somme_temps);
+    free(res->classes_persistantes);
+    free(res->absorptions);
+    free(res);
+}
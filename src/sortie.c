@@ -0,0 +1,344 @@
+#include "sortie.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/* Écriture des résultats en texte lisible, en JSON (un objet par chaîne et
+ * par ligne) ou en CSV (une valeur par ligne : chaine,section,ligne,cle,valeur).
+ * Rien n'est écrit au niveau SILENCIEUX, sauf les erreurs.
+ */
+
+// Écrit une chaîne JSON entre guillemets, caractères spéciaux échappés
+void sortie_chaine_json(FILE *f, const char *texte) {
+    fputc('"', f);
+    for (const unsigned char *c = (const unsigned char*)texte; *c != '\0'; c++) {
+        if (*c == '"' || *c == '\\') {
+            fputc('\\', f);
+            fputc(*c, f);
+        } else if (*c < 0x20) {
+            fprintf(f, "\\u%04x", *c);
+        } else {
+            fputc(*c, f);
+        }
+    }
+    fputc('"', f);
+}
+
+// Écrit un champ CSV, entre guillemets s'il contient un séparateur
+static void ecrire_champ_csv(FILE *f, const char *texte) {
+    if (strpbrk(texte, ",\"\n") == NULL) {
+        fputs(texte, f);
+        return;
+    }
+    fputc('"', f);
+    for (const char *c = texte; *c != '\0'; c++) {
+        if (*c == '"') fputc('"', f);
+        fputc(*c, f);
+    }
+    fputc('"', f);
+}
+
+// Vrai si un élément a déjà été écrit au niveau d'imbrication courant (il faut alors un séparateur)
+static int separateur(t_sortie *s) {
+    int besoin = !s->premier[s->profondeur];
+    s->premier[s->profondeur] = 0;
+    return besoin;
+}
+
+static void ouvrir(t_sortie *s, char c) {
+    if (s->format == FORMAT_JSON) fputc(c, s->fichier);
+    if (s->profondeur < SORTIE_PROFONDEUR_MAX - 1) s->profondeur++;
+    s->premier[s->profondeur] = 1;
+}
+
+static void fermer(t_sortie *s, char c) {
+    if (s->format == FORMAT_JSON) fputc(c, s->fichier);
+    if (s->profondeur > 0) s->profondeur--;
+}
+
+// Écrit "cle": en JSON, le début de ligne en CSV, "cle = " ou "cle : " en texte
+static void debut_champ(t_sortie *s, const char *cle) {
+    FILE *f = s->fichier;
+    switch (s->format) {
+        case FORMAT_JSON:
+            if (separateur(s)) fputc(',', f);
+            sortie_chaine_json(f, cle);
+            fputc(':', f);
+            break;
+        case FORMAT_CSV:
+            ecrire_champ_csv(f, s->chaine);
+            fputc(',', f);
+            ecrire_champ_csv(f, s->section);
+            fputc(',', f);
+            if (s->dans_ligne) fprintf(f, "%d", s->ligne);
+            fputc(',', f);
+            if (s->table[0] != '\0') {
+                ecrire_champ_csv(f, s->table);
+                fputc('.', f);
+            }
+            ecrire_champ_csv(f, cle);
+            fputc(',', f);
+            break;
+        case FORMAT_TEXTE:
+            if (s->dans_ligne) {
+                if (separateur(s)) fputs(", ", f);
+                fprintf(f, "%s = ", cle);
+            } else {
+                fprintf(f, "%s : ", cle);
+            }
+            break;
+    }
+}
+
+static void fin_champ(t_sortie *s) {
+    if (s->format == FORMAT_CSV || (s->format == FORMAT_TEXTE && !s->dans_ligne)) {
+        fputc('\n', s->fichier);
+    }
+}
+
+//Fonction qui crée une sortie sur un fichier déjà ouvert (le fichier reste à fermer par l'appelant)
+t_sortie* creer_sortie(FILE *fichier, t_format_sortie format, t_niveau niveau) {
+    t_sortie *s = calloc(1, sizeof(t_sortie));
+    s->fichier = fichier;
+    s->format = format;
+    s->niveau = niveau;
+    s->premier[0] = 1;
+    if (format == FORMAT_CSV) {
+        fprintf(fichier, "chaine,section,ligne,cle,valeur\n");
+    }
+    return s;
+}
+
+// Vrai si les données du niveau demandé doivent être écrites
+int sortie_actif(const t_sortie *s, t_niveau niveau) {
+    return s != NULL && s->niveau >= niveau;
+}
+
+// Nom de la chaîne en cours (repris par les erreurs écrites avant sortie_debut_chaine)
+void sortie_nommer_chaine(t_sortie *s, const char *nom) {
+    snprintf(s->chaine, sizeof(s->chaine), "%s", nom);
+    s->section[0] = '\0';
+    s->table[0] = '\0';
+}
+
+void sortie_debut_chaine(t_sortie *s, const char *nom, int nb_sommets, long long nb_aretes) {
+    sortie_nommer_chaine(s, nom);
+    if (!sortie_actif(s, NIVEAU_RESUME)) return;
+    s->chaine_ouverte = 1;
+
+    switch (s->format) {
+        case FORMAT_JSON:
+            ouvrir(s, '{');
+            sortie_texte(s, "chaine", nom);
+            sortie_entier(s, "sommets", nb_sommets);
+            sortie_entier(s, "aretes", nb_aretes);
+            debut_champ(s, "sections");
+            ouvrir(s, '{');
+            break;
+        case FORMAT_CSV:
+            sortie_entier(s, "sommets", nb_sommets);
+            sortie_entier(s, "aretes", nb_aretes);
+            break;
+        case FORMAT_TEXTE:
+            fprintf(s->fichier, "=== Chaine %s (%d sommets, %lld aretes) ===\n", nom, nb_sommets, nb_aretes);
+            break;
+    }
+}
+
+void sortie_fin_chaine(t_sortie *s) {
+    if (!s->chaine_ouverte) return;
+    s->chaine_ouverte = 0;
+    if (s->format == FORMAT_JSON) {
+        fermer(s, '}');
+        fermer(s, '}');
+        fputc('\n', s->fichier);
+    }
+    fflush(s->fichier);
+}
+
+void sortie_debut_section(t_sortie *s, const char *cle, const char *titre) {
+    snprintf(s->section, sizeof(s->section), "%s", cle);
+    if (!sortie_actif(s, NIVEAU_RESUME)) return;
+    if (s->format == FORMAT_JSON) {
+        debut_champ(s, cle);
+        ouvrir(s, '{');
+    } else if (s->format == FORMAT_TEXTE) {
+        fprintf(s->fichier, "\n%s :\n", titre);
+    }
+}
+
+void sortie_fin_section(t_sortie *s) {
+    s->section[0] = '\0';
+    if (!sortie_actif(s, NIVEAU_RESUME)) return;
+    if (s->format == FORMAT_JSON) fermer(s, '}');
+}
+
+void sortie_debut_table(t_sortie *s, const char *cle) {
+    snprintf(s->table, sizeof(s->table), "%s", cle);
+    s->ligne = 0;
+    if (!sortie_actif(s, NIVEAU_RESUME)) return;
+    if (s->format == FORMAT_JSON) {
+        debut_champ(s, cle);
+        ouvrir(s, '[');
+    }
+}
+
+void sortie_fin_table(t_sortie *s) {
+    s->table[0] = '\0';
+    if (!sortie_actif(s, NIVEAU_RESUME)) return;
+    if (s->format == FORMAT_JSON) fermer(s, ']');
+}
+
+void sortie_debut_ligne(t_sortie *s) {
+    s->ligne++;
+    if (!sortie_actif(s, NIVEAU_RESUME)) return;
+    if (s->format == FORMAT_JSON && separateur(s)) fputc(',', s->fichier);
+    ouvrir(s, '{');
+    s->dans_ligne = 1;
+}
+
+void sortie_fin_ligne(t_sortie *s) {
+    if (!sortie_actif(s, NIVEAU_RESUME)) return;
+    fermer(s, '}');
+    s->dans_ligne = 0;
+    if (s->format == FORMAT_TEXTE) fputc('\n', s->fichier);
+}
+
+void sortie_entier(t_sortie *s, const char *cle, long long valeur) {
+    if (!sortie_actif(s, NIVEAU_RESUME)) return;
+    debut_champ(s, cle);
+    fprintf(s->fichier, "%lld", valeur);
+    fin_champ(s);
+}
+
+// Réel machine (JSON, CSV) : une valeur non finie devient null en JSON et un champ vide en CSV
+static void ecrire_reel(t_sortie *s, double valeur) {
+    if (isfinite(valeur)) fprintf(s->fichier, "%.9g", valeur);
+    else if (s->format == FORMAT_JSON) fputs("null", s->fichier);
+}
+
+void sortie_reel(t_sortie *s, const char *cle, double valeur) {
+    if (!sortie_actif(s, NIVEAU_RESUME)) return;
+    debut_champ(s, cle);
+    if (s->format == FORMAT_TEXTE) {
+        fprintf(s->fichier, "%.6f", valeur);
+    } else {
+        ecrire_reel(s, valeur);
+    }
+    fin_champ(s);
+}
+
+void sortie_booleen(t_sortie *s, const char *cle, int valeur) {
+    if (!sortie_actif(s, NIVEAU_RESUME)) return;
+    debut_champ(s, cle);
+    if (s->format == FORMAT_TEXTE) fputs(valeur ? "oui" : "non", s->fichier);
+    else fputs(valeur ? "true" : "false", s->fichier);
+    fin_champ(s);
+}
+
+void sortie_texte(t_sortie *s, const char *cle, const char *valeur) {
+    if (!sortie_actif(s, NIVEAU_RESUME)) return;
+    debut_champ(s, cle);
+    if (s->format == FORMAT_JSON) sortie_chaine_json(s->fichier, valeur);
+    else if (s->format == FORMAT_CSV) ecrire_champ_csv(s->fichier, valeur);
+    else fputs(valeur, s->fichier);
+    fin_champ(s);
+}
+
+// Liste d'entiers : {1,2,3} en texte, [1,2,3] en JSON, 1;2;3 en CSV
+void sortie_liste_entiers(t_sortie *s, const char *cle, const int *valeurs, int nb) {
+    if (!sortie_actif(s, NIVEAU_RESUME)) return;
+    const char *ouvrant = (s->format == FORMAT_JSON) ? "[" : (s->format == FORMAT_TEXTE ? "{" : "");
+    const char *fermant = (s->format == FORMAT_JSON) ? "]" : (s->format == FORMAT_TEXTE ? "}" : "");
+    char sep = (s->format == FORMAT_CSV) ? ';' : ',';
+
+    debut_champ(s, cle);
+    fputs(ouvrant, s->fichier);
+    for (int i = 0; i < nb; i++) {
+        if (i > 0) fputc(sep, s->fichier);
+        fprintf(s->fichier, "%d", valeurs[i]);
+    }
+    fputs(fermant, s->fichier);
+    fin_champ(s);
+}
+
+// Matrice : lignes séparées par des tabulations en texte, tableau de tableaux en JSON, une case par ligne en CSV
+void sortie_matrice(t_sortie *s, const char *cle, t_matrix *m) {
+    if (!sortie_actif(s, NIVEAU_RESUME)) return;
+    FILE *f = s->fichier;
+
+    if (s->format == FORMAT_CSV) {
+        int ligne = s->ligne, dans_ligne = s->dans_ligne;
+        char nom[96];
+        s->dans_ligne = 1;
+        for (int i = 0; i < m->lignes; i++) {
+            s->ligne = i + 1;
+            for (int j = 0; j < m->cols; j++) {
+                snprintf(nom, sizeof(nom), "%s.%d", cle, j + 1);
+                debut_champ(s, nom);
+                ecrire_reel(s, m->data[i][j]);
+                fin_champ(s);
+            }
+        }
+        s->ligne = ligne;
+        s->dans_ligne = dans_ligne;
+        return;
+    }
+
+    if (s->format == FORMAT_JSON) {
+        debut_champ(s, cle);
+        fputc('[', f);
+        for (int i = 0; i < m->lignes; i++) {
+            fputs(i > 0 ? ",[" : "[", f);
+            for (int j = 0; j < m->cols; j++) {
+                if (j > 0) fputc(',', f);
+                ecrire_reel(s, m->data[i][j]);
+            }
+            fputc(']', f);
+        }
+        fputc(']', f);
+    } else {
+        fprintf(f, "%s :\n", cle);
+        for (int i = 0; i < m->lignes; i++) {
+            for (int j = 0; j < m->cols; j++) {
+                fprintf(f, "%.4f%s", m->data[i][j], (j < m->cols - 1) ? "\t" : "\n");
+            }
+        }
+    }
+}
+
+// Erreur : toujours écrite, quel que soit le niveau
+void sortie_erreur(t_sortie *s, const char *message) {
+    FILE *f = s->fichier;
+    switch (s->format) {
+        case FORMAT_JSON:
+            if (s->chaine_ouverte) {
+                debut_champ(s, "erreur");
+                sortie_chaine_json(f, message);
+            } else {
+                fputs("{\"chaine\":", f);
+                sortie_chaine_json(f, s->chaine);
+                fputs(",\"erreur\":", f);
+                sortie_chaine_json(f, message);
+                fputs("}\n", f);
+            }
+            break;
+        case FORMAT_CSV:
+            ecrire_champ_csv(f, s->chaine);
+            fputs(",erreur,,message,", f);
+            ecrire_champ_csv(f, message);
+            fputc('\n', f);
+            break;
+        case FORMAT_TEXTE:
+            fprintf(f, "ERREUR : %s\n", message);
+            break;
+    }
+}
+
+// Libère la sortie (sans fermer le fichier)
+void liberer_sortie(t_sortie *s) {
+    if (s == NULL) return;
+    fflush(s->fichier);
+    free(s);
+}
@@ -0,0 +1,266 @@
+#include "spectre.h"
+#include <stdlib.h>
+#include <math.h>
+#include <float.h>
+#include <complex.h>
+#include "alea.h"
+#include "hasse.h"
+
+// Graine du vecteur de départ d'Arnoldi (résultat reproductible)
+#define GRAINE_ARNOLDI 0x5eedULL
+
+// Nombre maximal d'itérations QR par valeur propre
+#define MAX_ITER_QR 100
+
+/* Valeurs propres d'une matrice de Hessenberg supérieure par itérations QR à
+ * décalage simple en arithmétique complexe : chaque pas factorise H - mu I par
+ * rotations de Givens, puis forme RQ + mu I (toujours Hessenberg, mêmes valeurs
+ * propres). Le décalage mu est la valeur propre du bloc 2 x 2 final la plus
+ * proche du dernier coefficient diagonal ; dès qu'un coefficient sous-diagonal
+ * est négligeable, la matrice se découple et le bloc du bas est traité seul.
+ * Les valeurs propres complexes d'une matrice réelle sortent en paires
+ * conjuguées (aux arrondis près). h est indexée de 1 à n et n'est pas modifiée.
+ * Renvoie 0, ou -1 si une valeur propre ne converge pas.
+ */
+static int valeurs_propres_hessenberg(double **h, int n, double *wr, double *wi) {
+    double complex *a = malloc((size_t)(n > 0 ? n : 1) * n * sizeof(double complex));
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) a[i * n + j] = (j >= i - 1) ? h[i + 1][j + 1] : 0.0;
+    }
+#define A(i, j) a[(i) * n + (j)]
+
+    int fin = n - 1;
+    int iterations = 0;
+    while (fin >= 0) {
+        // Plus petit début du bloc actif : au-dessus, un coefficient sous-diagonal négligeable le sépare
+        int debut = fin;
+        while (debut > 0) {
+            double voisins = cabs(A(debut, debut)) + cabs(A(debut - 1, debut - 1));
+            if (cabs(A(debut, debut - 1)) <= DBL_EPSILON * voisins) {
+                A(debut, debut - 1) = 0.0;
+                break;
+            }
+            debut--;
+        }
+        if (debut == fin) {
+            wr[fin + 1] = creal(A(fin, fin));
+            wi[fin + 1] = cimag(A(fin, fin));
+            fin--;
+            iterations = 0;
+            continue;
+        }
+        if (++iterations > MAX_ITER_QR) {
+            free(a);
+            return -1;
+        }
+
+        // Décalage : valeur propre du bloc 2 x 2 final la plus proche de A(fin, fin)
+        double complex p = A(fin - 1, fin - 1), q = A(fin - 1, fin);
+        double complex r = A(fin, fin - 1), t = A(fin, fin);
+        double complex demi_trace = 0.5 * (p + t);
+        double complex racine = csqrt(demi_trace * demi_trace - (p * t - q * r));
+        double complex mu1 = demi_trace + racine, mu2 = demi_trace - racine;
+        double complex mu = (cabs(mu1 - t) <= cabs(mu2 - t)) ? mu1 : mu2;
+        // Décalage exceptionnel tous les 11 pas sans découplage, pour sortir d'un cycle
+        if (iterations % 11 == 0) mu = t + cabs(r) * (0.75 + 0.5 * I);
+
+        // H - mu I = QR : la rotation k annule A(k + 1, k) (rotations gardées pour former RQ)
+        int taille = fin - debut;
+        double complex *c = malloc((size_t)(taille > 0 ? taille : 1) * sizeof(double complex));
+        double complex *s = malloc((size_t)(taille > 0 ? taille : 1) * sizeof(double complex));
+        for (int k = debut; k <= fin; k++) A(k, k) -= mu;
+        for (int k = debut; k < fin; k++) {
+            double complex x = A(k, k), y = A(k + 1, k);
+            double norme = hypot(cabs(x), cabs(y));
+            double complex ck = (norme > 0.0) ? x / norme : 1.0;
+            double complex sk = (norme > 0.0) ? y / norme : 0.0;
+            c[k - debut] = ck;
+            s[k - debut] = sk;
+            for (int j = k; j <= fin; j++) {
+                double complex u = A(k, j), v = A(k + 1, j);
+                A(k, j) = conj(ck) * u + conj(sk) * v;
+                A(k + 1, j) = -sk * u + ck * v;
+            }
+        }
+        // RQ : les rotations transposées conjuguées, appliquées aux colonnes
+        for (int k = debut; k < fin; k++) {
+            double complex ck = c[k - debut], sk = s[k - debut];
+            for (int i = debut; i <= k + 1; i++) {
+                double complex u = A(i, k), v = A(i, k + 1);
+                A(i, k) = u * ck + v * sk;
+                A(i, k + 1) = -u * conj(sk) + v * conj(ck);
+            }
+        }
+        for (int k = debut; k <= fin; k++) A(k, k) += mu;
+        free(s);
+        free(c);
+    }
+#undef A
+
+    free(a);
+    return 0;
+}
+
+// y = x P restreint à la classe (indices locaux), puis projection sur les vecteurs de somme nulle
+static void produit_classe(listeAdj *g, t_classe *classe, const int *local, const double *x, double *y) {
+    int taille = classe->taille;
+    for (int s = 0; s < taille; s++) y[s] = 0.0;
+    for (int s = 0; s < taille; s++) {
+        if (x[s] == 0.0) continue;
+        for (cell *c = g->tab_liste[classe->sommets[s] - 1].head; c != NULL; c = c->suivante) {
+            int t = local[c->sommet_arrivee - 1];
+            if (t >= 0) y[t] += x[s] * c->proba;
+        }
+    }
+    // Les probabilités lues en float ne somment pas exactement à 1 : on retire la dérive
+    double moyenne = 0.0;
+    for (int s = 0; s < taille; s++) moyenne += y[s];
+    moyenne /= taille;
+    for (int s = 0; s < taille; s++) y[s] -= moyenne;
+}
+
+static double produit_scalaire(const double *a, const double *b, int n) {
+    double somme = 0.0;
+    for (int i = 0; i < n; i++) somme += a[i] * b[i];
+    return somme;
+}
+
+// Arnoldi sur une classe persistante : renvoie le SLEM de P et de (P + I) / 2, et la dimension utilisée
+static int arnoldi_classe(listeAdj *g, t_classe *classe, const int *local, int dimension_max,
+                          double *slem, double *slem_paresseuse, long long *produits) {
+    int taille = classe->taille;
+    *slem = 0.0;
+    *slem_paresseuse = 0.0;
+    if (taille < 2) return 0;
+
+    // Le sous-espace des vecteurs de somme nulle est de dimension taille - 1
+    int m = (dimension_max < taille - 1) ? dimension_max : taille - 1;
+    double **v = malloc((m + 1) * sizeof(double*));
+    double **h = malloc((m + 2) * sizeof(double*));
+    for (int j = 0; j <= m; j++) v[j] = malloc(taille * sizeof(double));
+    for (int i = 0; i <= m + 1; i++) h[i] = calloc(m + 2, sizeof(double));
+
+    // Vecteur de départ pseudo-aléatoire, centré puis normé
+    unsigned long long cle = alea_cle(GRAINE_ARNOLDI, (unsigned long long)classe->sommets[0]);
+    double moyenne = 0.0;
+    for (int s = 0; s < taille; s++) {
+        v[0][s] = alea_uniforme(cle, (unsigned long long)s);
+        moyenne += v[0][s];
+    }
+    moyenne /= taille;
+    for (int s = 0; s < taille; s++) v[0][s] -= moyenne;
+    double norme = sqrt(produit_scalaire(v[0], v[0], taille));
+    for (int s = 0; s < taille; s++) v[0][s] /= norme;
+
+    // Gram-Schmidt modifié, appliqué deux fois pour garder une base orthonormée
+    int dimension = m;
+    for (int j = 0; j < m; j++) {
+        produit_classe(g, classe, local, v[j], v[j + 1]);
+        (*produits)++;
+        for (int passe = 0; passe < 2; passe++) {
+            for (int i = 0; i <= j; i++) {
+                double hij = produit_scalaire(v[i], v[j + 1], taille);
+                h[i + 1][j + 1] += hij;
+                for (int s = 0; s < taille; s++) v[j + 1][s] -= hij * v[i][s];
+            }
+        }
+        double suivant = sqrt(produit_scalaire(v[j + 1], v[j + 1], taille));
+        // Sous-espace invariant trouvé : les valeurs de Ritz sont exactes
+        if (suivant < 1e-12 || j == m - 1) {
+            dimension = j + 1;
+            break;
+        }
+        h[j + 2][j + 1] = suivant;
+        for (int s = 0; s < taille; s++) v[j + 1][s] /= suivant;
+    }
+
+    double *wr = malloc((dimension + 1) * sizeof(double));
+    double *wi = malloc((dimension + 1) * sizeof(double));
+    if (valeurs_propres_hessenberg(h, dimension, wr, wi) == 0) {
+        for (int i = 1; i <= dimension; i++) {
+            double module = hypot(wr[i], wi[i]);
+            double module_paresseux = hypot(0.5 * (wr[i] + 1.0), 0.5 * wi[i]);
+            if (module > *slem) *slem = module;
+            if (module_paresseux > *slem_paresseuse) *slem_paresseuse = module_paresseux;
+        }
+    } else {
+        // QR sans convergence : estimation prudente
+        *slem = 1.0;
+        *slem_paresseuse = 1.0;
+    }
+    if (*slem > 1.0) *slem = 1.0;
+    if (*slem_paresseuse > 1.0) *slem_paresseuse = 1.0;
+
+    free(wr);
+    free(wi);
+    for (int j = 0; j <= m; j++) free(v[j]);
+    for (int i = 0; i <= m + 1; i++) free(h[i]);
+    free(v);
+    free(h);
+    return dimension;
+}
+
+//Fonction qui estime le SLEM de chaque classe persistante par Arnoldi
+t_spectre* estimer_spectre(listeAdj *g, t_partition *partition, int dimension_max) {
+    int n = g->nb_sommets;
+    int *estPersistante = calculer_persistance(partition, g);
+
+    t_spectre *sp = malloc(sizeof(t_spectre));
+    sp->nb_classes = 0;
+    sp->produits = 0;
+    int capacite = (partition->taille > 0) ? partition->taille : 1;
+    sp->classes = malloc(capacite * sizeof(int));
+    sp->slem = malloc(capacite * sizeof(double));
+    sp->slem_paresseuse = malloc(capacite * sizeof(double));
+    sp->dimension = malloc(capacite * sizeof(int));
+
+    // Indice local de chaque sommet dans sa classe (-1 hors de la classe traitée)
+    int *local = malloc((n > 0 ? n : 1) * sizeof(int));
+    for (int i = 0; i < n; i++) local[i] = -1;
+
+    for (int c = 0; c < partition->taille; c++) {
+        if (!estPersistante[c]) continue;
+        t_classe *classe = &partition->classes[c];
+        for (int s = 0; s < classe->taille; s++) local[classe->sommets[s] - 1] = s;
+
+        int k = sp->nb_classes++;
+        sp->classes[k] = c;
+        sp->dimension[k] = arnoldi_classe(g, classe, local, dimension_max,
+                                          &sp->slem[k], &sp->slem_paresseuse[k], &sp->produits);
+
+        for (int s = 0; s < classe->taille; s++) local[classe->sommets[s] - 1] = -1;
+    }
+
+    free(local);
+    free(estPersistante);
+    return sp;
+}
+
+// Nombre de pas pour que l'écart à la loi stationnaire soit réduit d'un facteur epsilon (-1 si infini)
+int spectre_temps_melange(double slem, double epsilon) {
+    if (slem <= 0.0) return 1;
+    if (slem >= 1.0 - 1e-12) return -1;
+    double pas = ceil(log(epsilon) / log(slem));
+    return (pas < 1.0) ? 1 : (pas > 1e9 ? 1000000000 : (int)pas);
+}
+
+// Itérations prévues pour calculer_limite (chaîne paresseuse) à la précision epsilon, -1 si infini
+int spectre_iterations_limite(const t_spectre *sp, double epsilon) {
+    int iterations = 1;
+    for (int k = 0; k < sp->nb_classes; k++) {
+        int t = spectre_temps_melange(sp->slem_paresseuse[k], epsilon);
+        if (t < 0) return -1;
+        if (t > iterations) iterations = t;
+    }
+    return iterations;
+}
+
+// Libère la mémoire d'une estimation spectrale
+void liberer_spectre(t_spectre *sp) {
+    if (sp == NULL) return;
+    free(sp->classes);
+    free(sp->slem);
+    free(sp->slem_paresseuse);
+    free(sp->dimension);
+    free(sp);
+}
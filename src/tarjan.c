@@ -107,14 +107,6 @@ void tarjan_parcours(t_tarjan_data *data, int sommet_index) {
         if (data->partition != NULL) {
             ajouter_classe(data->partition, composante, taille_composante);
         }
-
-        // Affichage des composantes
-        printf("Composante C%d: {", data->partition->taille);
-        for (int i = taille_composante - 1; i >= 0; i--) {
-            printf("%d", composante[i]);
-            if (i > 0) printf(",");
-        }
-        printf("}\n");
     }
 }
 
@@ -135,8 +127,6 @@ t_partition* tarjan_calculer_partition(listeAdj g) {
     data->partition->taille = 0;
     data->partition->capacite = g.nb_sommets;
 
-    printf("Algorithme de Tarjan\n");
-
     // Application de l'algorithme de Tarjan
     for (int i = 0; i < g.nb_sommets; i++) {
         if (data->sommets[i].num == -1) {
@@ -148,17 +138,13 @@ t_partition* tarjan_calculer_partition(listeAdj g) {
     return resultat;
 }
 
-// Fonction pour afficher une partition
-void afficher_partition(t_partition *partition) {
-    printf("Partition du graphe :\n");
-
+// Libère une partition et les sommets de chaque classe
+void liberer_partition(t_partition *partition) {
+    if (partition == NULL) return;
     for (int i = 0; i < partition->taille; i++) {
-        printf("%s: {", partition->classes[i].nom);
-
-        for (int j = 0; j < partition->classes[i].taille; j++) {
-            printf("%d", partition->classes[i].sommets[j]);
-            if (j < partition->classes[i].taille - 1) printf(",");
-        }
-        printf("}\n");
+        free(partition->classes[i].sommets);
     }
-}
\ No newline at end of file
+    free(partition->classes);
+    free(partition);
+}
+
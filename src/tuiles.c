@@ -0,0 +1,268 @@
+#include "tuiles.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#define TUILES_MAGIQUE "MKVTUILE"
+#define TUILES_VERSION 1
+#define TAILLE_ENTETE 4096
+
+// En-tête du fichier (au début de la première page)
+typedef struct {
+    char magique[8];
+    int version;
+    int lignes;
+    int cols;
+    int taille_tuile;
+} t_entete_tuiles;
+
+static size_t octets_tuile(const t_matrice_tuiles *m) {
+    return (size_t)m->taille_tuile * m->taille_tuile * sizeof(double);
+}
+
+// Début de la tuile (bi, bj) : les tuiles sont rangées ligne de tuiles par ligne de tuiles
+double* tuile(const t_matrice_tuiles *m, int bi, int bj) {
+    size_t indice = (size_t)bi * m->tuiles_cols + bj;
+    return m->donnees + indice * m->taille_tuile * m->taille_tuile;
+}
+
+double tuiles_lire(const t_matrice_tuiles *m, int i, int j) {
+    int T = m->taille_tuile;
+    return tuile(m, i / T, j / T)[(size_t)(i % T) * T + j % T];
+}
+
+void tuiles_ecrire(t_matrice_tuiles *m, int i, int j, double valeur) {
+    int T = m->taille_tuile;
+    tuile(m, i / T, j / T)[(size_t)(i % T) * T + j % T] = valeur;
+}
+
+#if !defined(_WIN32)
+
+// Conseil au noyau sur une tuile (ignoré si la tuile n'existe pas)
+static void conseiller_tuile(const t_matrice_tuiles *m, int bi, int bj, int conseil) {
+    if (bi < 0 || bj < 0 || bi >= m->tuiles_lignes || bj >= m->tuiles_cols) return;
+    madvise(tuile(m, bi, bj), octets_tuile(m), conseil);
+}
+
+// Projette le fichier déjà dimensionné et remplit les champs dérivés
+static t_matrice_tuiles* projeter(const char *chemin, int fd, int lignes, int cols, int taille_tuile) {
+    t_matrice_tuiles *m = calloc(1, sizeof(t_matrice_tuiles));
+    if (m == NULL) return NULL;
+    m->lignes = lignes;
+    m->cols = cols;
+    m->taille_tuile = taille_tuile;
+    m->tuiles_lignes = (lignes + taille_tuile - 1) / taille_tuile;
+    m->tuiles_cols = (cols + taille_tuile - 1) / taille_tuile;
+    m->fd = fd;
+    m->taille = TAILLE_ENTETE + (size_t)m->tuiles_lignes * m->tuiles_cols * octets_tuile(m);
+
+    void *p = mmap(NULL, m->taille, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    m->chemin = malloc(strlen(chemin) + 1);
+    if (p == MAP_FAILED || m->chemin == NULL) {
+        if (p != MAP_FAILED) munmap(p, m->taille);
+        free(m->chemin);
+        free(m);
+        return NULL;
+    }
+    strcpy(m->chemin, chemin);
+    m->projection = p;
+    m->donnees = (double*)(m->projection + TAILLE_ENTETE);
+    return m;
+}
+
+//Fonction qui crée une matrice nulle sur le fichier chemin (écrasé), NULL en cas d'erreur
+t_matrice_tuiles* creer_matrice_tuiles(const char *chemin, int lignes, int cols, int taille_tuile) {
+    if (lignes <= 0 || cols <= 0 || taille_tuile <= 0 || taille_tuile % MULTIPLE_TUILE != 0) return NULL;
+
+    int fd = open(chemin, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return NULL;
+
+    // Fichier creux : les tuiles jamais écrites ne prennent pas de place et valent 0
+    size_t tuiles = (size_t)((lignes + taille_tuile - 1) / taille_tuile) * ((cols + taille_tuile - 1) / taille_tuile);
+    size_t taille = TAILLE_ENTETE + tuiles * taille_tuile * taille_tuile * sizeof(double);
+    if (ftruncate(fd, (off_t)taille) != 0) {
+        close(fd);
+        remove(chemin);
+        return NULL;
+    }
+
+    t_matrice_tuiles *m = projeter(chemin, fd, lignes, cols, taille_tuile);
+    if (m == NULL) {
+        close(fd);
+        remove(chemin);
+        return NULL;
+    }
+    t_entete_tuiles entete = {{0}, TUILES_VERSION, lignes, cols, taille_tuile};
+    memcpy(entete.magique, TUILES_MAGIQUE, 8);
+    memcpy(m->projection, &entete, sizeof(entete));
+    return m;
+}
+
+//Fonction qui ouvre une matrice existante, NULL si le fichier n'en est pas une
+t_matrice_tuiles* ouvrir_matrice_tuiles(const char *chemin) {
+    int fd = open(chemin, O_RDWR);
+    if (fd < 0) return NULL;
+
+    t_entete_tuiles entete;
+    struct stat st;
+    int ok = read(fd, &entete, sizeof(entete)) == (ssize_t)sizeof(entete)
+          && memcmp(entete.magique, TUILES_MAGIQUE, 8) == 0 && entete.version == TUILES_VERSION
+          && entete.lignes > 0 && entete.cols > 0
+          && entete.taille_tuile > 0 && entete.taille_tuile % MULTIPLE_TUILE == 0
+          && fstat(fd, &st) == 0;
+    t_matrice_tuiles *m = ok ? projeter(chemin, fd, entete.lignes, entete.cols, entete.taille_tuile) : NULL;
+    if (m != NULL && (size_t)st.st_size < m->taille) {
+        // Fichier tronqué : lire au-delà de la fin provoquerait SIGBUS
+        liberer_matrice_tuiles(m, 0);
+        return NULL;
+    }
+    if (m == NULL) close(fd);
+    return m;
+}
+
+//Fonction qui calcule C = A * B tuile par tuile dans le fichier chemin
+t_matrice_tuiles* multiplication_tuiles(const t_matrice_tuiles *A, const t_matrice_tuiles *B, const char *chemin) {
+    if (A == NULL || B == NULL || A->cols != B->lignes || A->taille_tuile != B->taille_tuile) return NULL;
+
+    t_matrice_tuiles *C = creer_matrice_tuiles(chemin, A->lignes, B->cols, A->taille_tuile);
+    if (C == NULL) return NULL;
+    int T = A->taille_tuile;
+    int nk = A->tuiles_cols;
+
+    for (int bi = 0; bi < C->tuiles_lignes; bi++) {
+        for (int bj = 0; bj < C->tuiles_cols; bj++) {
+            double *c = tuile(C, bi, bj);
+            for (int bk = 0; bk < nk; bk++) {
+                // Lecture anticipée des deux tuiles suivantes pendant le calcul de celle-ci
+                if (bk + 1 < nk) {
+                    conseiller_tuile(A, bi, bk + 1, MADV_WILLNEED);
+                    conseiller_tuile(B, bk + 1, bj, MADV_WILLNEED);
+                } else {
+                    conseiller_tuile(A, bi, 0, MADV_WILLNEED);
+                    conseiller_tuile(B, 0, bj + 1, MADV_WILLNEED);
+                }
+                const double *a = tuile(A, bi, bk);
+                const double *b = tuile(B, bk, bj);
+
+                // Ordre i-k-j : la boucle interne parcourt deux lignes contiguës (vectorisable)
+                for (int i = 0; i < T; i++) {
+                    double *restrict ci = c + (size_t)i * T;
+                    for (int k = 0; k < T; k++) {
+                        double aik = a[(size_t)i * T + k];
+                        if (aik == 0.0) continue;
+                        const double *restrict bk_ligne = b + (size_t)k * T;
+                        for (int j = 0; j < T; j++) ci[j] += aik * bk_ligne[j];
+                    }
+                }
+                conseiller_tuile(B, bk, bj, MADV_DONTNEED);
+            }
+            // Tuile terminée : écriture différée sur le disque, puis libération des pages
+            msync(c, octets_tuile(C), MS_ASYNC);
+            conseiller_tuile(C, bi, bj, MADV_DONTNEED);
+        }
+        for (int bk = 0; bk < nk; bk++) conseiller_tuile(A, bi, bk, MADV_DONTNEED);
+    }
+    return C;
+}
+
+//Fonction qui calcule la somme des différences absolues (comme difference_matrix), -1 si les tailles diffèrent
+double difference_tuiles(const t_matrice_tuiles *A, const t_matrice_tuiles *B) {
+    if (A->lignes != B->lignes || A->cols != B->cols || A->taille_tuile != B->taille_tuile) return -1.0;
+
+    // Les zéros de bord sont identiques dans les deux matrices : on peut sommer les tuiles entières
+    double difference = 0.0;
+    size_t nb = (size_t)A->taille_tuile * A->taille_tuile;
+    for (int bi = 0; bi < A->tuiles_lignes; bi++) {
+        for (int bj = 0; bj < A->tuiles_cols; bj++) {
+            int suivante = bj + 1 < A->tuiles_cols;
+            conseiller_tuile(A, suivante ? bi : bi + 1, suivante ? bj + 1 : 0, MADV_WILLNEED);
+            conseiller_tuile(B, suivante ? bi : bi + 1, suivante ? bj + 1 : 0, MADV_WILLNEED);
+            const double *a = tuile(A, bi, bj);
+            const double *b = tuile(B, bi, bj);
+            for (size_t v = 0; v < nb; v++) difference += fabs(a[v] - b[v]);
+            conseiller_tuile(A, bi, bj, MADV_DONTNEED);
+            conseiller_tuile(B, bi, bj, MADV_DONTNEED);
+        }
+    }
+    return difference;
+}
+
+// Libère la projection (les modifications sont écrites dans le fichier), et supprime le fichier si demandé
+void liberer_matrice_tuiles(t_matrice_tuiles *m, int supprimer_fichier) {
+    if (m == NULL) return;
+    munmap(m->projection, m->taille);
+    close(m->fd);
+    if (supprimer_fichier) remove(m->chemin);
+    free(m->chemin);
+    free(m);
+}
+
+#else
+
+// Pas de projection de fichier sous Windows : les matrices hors mémoire ne sont pas disponibles
+t_matrice_tuiles* creer_matrice_tuiles(const char *chemin, int lignes, int cols, int taille_tuile) {
+    (void)chemin; (void)lignes; (void)cols; (void)taille_tuile;
+    return NULL;
+}
+
+t_matrice_tuiles* ouvrir_matrice_tuiles(const char *chemin) {
+    (void)chemin;
+    return NULL;
+}
+
+t_matrice_tuiles* multiplication_tuiles(const t_matrice_tuiles *A, const t_matrice_tuiles *B, const char *chemin) {
+    (void)A; (void)B; (void)chemin;
+    return NULL;
+}
+
+double difference_tuiles(const t_matrice_tuiles *A, const t_matrice_tuiles *B) {
+    (void)A; (void)B;
+    return -1.0;
+}
+
+void liberer_matrice_tuiles(t_matrice_tuiles *m, int supprimer_fichier) {
+    (void)m; (void)supprimer_fichier;
+}
+
+#endif
+
+//Fonction qui écrit la matrice de transition de g dans un fichier de tuiles (sans matrice dense en mémoire)
+t_matrice_tuiles* tuiles_depuis_liste(listeAdj *g, const char *chemin, int taille_tuile) {
+    t_matrice_tuiles *m = creer_matrice_tuiles(chemin, g->nb_sommets, g->nb_sommets, taille_tuile);
+    if (m == NULL) return NULL;
+    for (int i = 0; i < g->nb_sommets; i++) {
+        for (cell *c = g->tab_liste[i].head; c != NULL; c = c->suivante) {
+            tuiles_ecrire(m, i, c->sommet_arrivee - 1, c->proba);
+        }
+    }
+    return m;
+}
+
+//Fonction qui copie une matrice en mémoire dans un fichier de tuiles
+t_matrice_tuiles* tuiles_depuis_matrice(t_matrix *matrice, const char *chemin, int taille_tuile) {
+    t_matrice_tuiles *m = creer_matrice_tuiles(chemin, matrice->lignes, matrice->cols, taille_tuile);
+    if (m == NULL) return NULL;
+    for (int i = 0; i < matrice->lignes; i++) {
+        for (int j = 0; j < matrice->cols; j++) {
+            if (matrice->data[i][j] != 0.0) tuiles_ecrire(m, i, j, matrice->data[i][j]);
+        }
+    }
+    return m;
+}
+
+//Fonction qui recopie une matrice de tuiles en mémoire (pour les petites matrices)
+t_matrix* tuiles_vers_matrice(const t_matrice_tuiles *m) {
+    t_matrix *matrice = creer_matrice_valzeros(m->lignes, m->cols);
+    for (int i = 0; i < m->lignes; i++) {
+        for (int j = 0; j < m->cols; j++) matrice->data[i][j] = tuiles_lire(m, i, j);
+    }
+    return matrice;
+}
@@ -5,25 +5,114 @@
 #include "utils.h"
 
 
-//Fonction qui transforme un nombre en chaine de caractere
-char* getID(int num) {
-  //allocation dynamique de la mémoire (max 10 caracteres)
-    char* id = malloc(10 * sizeof(char));
+//Fonction qui écrit l'identifiant d'un nombre (base 26 : A, B, ..., Z, AA, ...) dans buf, renvoie sa longueur
+int formaterID(int num, char *buf) {
     int index = 0;
     int temp = num;
 //Conversion nombre/lettre à partir d'une base 26
     while (temp > 0) {
         temp--;
-        id[index++] = 'A' + (temp % 26);
+        buf[index++] = 'A' + (temp % 26);
         temp /= 26;
     }
     // Inversion de la chaîne pour la remettre à l'endroit
     for (int i = 0; i < index / 2; i++) {
-        char tmp = id[i];
-        id[i] = id[index - 1 - i];
-        id[index - 1 - i] = tmp;
+        char tmp = buf[i];
+        buf[i] = buf[index - 1 - i];
+        buf[index - 1 - i] = tmp;
     }
 //ajout du caractère de fin de chaîne
-    id[index] = '\0';
+    buf[index] = '\0';
+    return index;
+}
+
+//Fonction qui transforme un nombre en chaine de caractere (à libérer par l'appelant)
+char* getID(int num) {
+  //allocation dynamique de la mémoire
+    char* id = malloc(TAILLE_ID * sizeof(char));
+    formaterID(num, id);
     return id;
-}
\ No newline at end of file
+}
+
+// Vide le tampon dans le fichier
+static void vider_tampon(t_tampon *t) {
+    if (t->pos > 0 && fwrite(t->buf, 1, t->pos, t->fichier) != t->pos) {
+        t->erreur = 1;
+    }
+    t->pos = 0;
+}
+
+// Ouvre un fichier en écriture avec un tampon de la capacité donnée (0 = taille par défaut)
+t_tampon* ouvrir_tampon(const char *nomFichier, size_t capacite) {
+    FILE *file = fopen(nomFichier, "w");
+    if (!file) {
+        return NULL;
+    }
+    if (capacite == 0) capacite = TAILLE_TAMPON_SORTIE;
+
+    t_tampon *t = malloc(sizeof(t_tampon));
+    t->fichier = file;
+    t->buf = malloc(capacite);
+    t->capacite = capacite;
+    t->pos = 0;
+    t->erreur = 0;
+    return t;
+}
+
+// Ajoute des octets au tampon, en vidant si nécessaire
+void tampon_ecrire(t_tampon *t, const char *donnees, size_t taille) {
+    if (t->pos + taille > t->capacite) {
+        vider_tampon(t);
+        // Bloc plus gros que le tampon : écriture directe
+        if (taille > t->capacite) {
+            if (fwrite(donnees, 1, taille, t->fichier) != taille) t->erreur = 1;
+            return;
+        }
+    }
+    memcpy(t->buf + t->pos, donnees, taille);
+    t->pos += taille;
+}
+
+void tampon_chaine(t_tampon *t, const char *chaine) {
+    tampon_ecrire(t, chaine, strlen(chaine));
+}
+
+// Écrit un entier en décimal (équivalent de "%d")
+void tampon_entier(t_tampon *t, int valeur) {
+    char buf[16];
+    int pos = sizeof(buf);
+    unsigned int v = (valeur < 0) ? 0u - (unsigned int)valeur : (unsigned int)valeur;
+
+    do {
+        buf[--pos] = (char)('0' + v % 10);
+        v /= 10;
+    } while (v > 0);
+    if (valeur < 0) buf[--pos] = '-';
+
+    tampon_ecrire(t, buf + pos, sizeof(buf) - pos);
+}
+
+// Écrit l'identifiant Mermaid d'un sommet ou d'une classe, sans allocation
+void tampon_id(t_tampon *t, int num) {
+    char id[TAILLE_ID];
+    int len = formaterID(num, id);
+    tampon_ecrire(t, id, len);
+}
+
+// Écrit une probabilité au format "%.2f" (même arrondi que fprintf)
+void tampon_proba(t_tampon *t, double proba) {
+    char buf[32];
+    int len = snprintf(buf, sizeof(buf), "%.2f", proba);
+    if (len > 0) tampon_ecrire(t, buf, (size_t)len);
+}
+
+// Vide le tampon, ferme le fichier et libère la mémoire. Renvoie 0 si tout s'est bien passé
+int fermer_tampon(t_tampon *t) {
+    if (t == NULL) return -1;
+    vider_tampon(t);
+    int erreur = t->erreur;
+    if (fclose(t->fichier) != 0) erreur = 1;
+    free(t->buf);
+    free(t);
+    return erreur ? -1 : 0;
+}